@@ -0,0 +1,73 @@
+#include <biginteger/biginteger.hpp>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using Numerics::BigInteger;
+using Numerics::detail::ArithmeticOperations;
+using Numerics::detail::ConstantTime;
+using Numerics::detail::VariableTime;
+
+namespace
+{
+
+BigInteger random_odd(std::mt19937_64& gen, size_t bits)
+{
+    std::vector<uint64_t> limbs(bits / 64);
+    for (auto& limb : limbs)
+        limb = gen();
+    limbs.front() |= 1;
+    limbs.back() |= uint64_t(1) << 63;
+    return BigInteger::from_limbs(limbs);
+}
+
+// Average milliseconds per exponentiation over a fixed number of runs.
+template <typename Policy>
+double time_modular_pow(const BigInteger& base, const BigInteger& exponent,
+                        const BigInteger& modulus, int runs)
+{
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < runs; ++i)
+    {
+        const BigInteger result =
+            ArithmeticOperations::modular_pow<Policy>(base, exponent, modulus);
+        if (result.is_negative())
+            std::abort();
+    }
+    const std::chrono::duration<double, std::milli> elapsed =
+        std::chrono::steady_clock::now() - start;
+    return elapsed.count() / runs;
+}
+
+} // namespace
+
+// Compares variable-time and constant-time modular exponentiation with full-size exponents,
+// as in RSA private-key operations.
+int main()
+{
+    std::mt19937_64 gen(2024);
+
+    (void)std::printf("%8s %16s %16s %8s\n", "bits", "variable (ms)", "constant (ms)", "ratio");
+    for (size_t bits : {512, 1024, 2048, 4096})
+    {
+        const BigInteger modulus = random_odd(gen, bits);
+        const BigInteger exponent = random_odd(gen, bits) % modulus;
+        const BigInteger base = random_odd(gen, bits) % modulus;
+        const int runs = bits >= 4096 ? 3 : 20;
+
+        if (ArithmeticOperations::modular_pow<VariableTime>(base, exponent, modulus) !=
+            ArithmeticOperations::modular_pow<ConstantTime>(base, exponent, modulus))
+        {
+            (void)std::fprintf(stderr, "Mismatch at %zu bits\n", bits);
+            return 1;
+        }
+
+        const double variable = time_modular_pow<VariableTime>(base, exponent, modulus, runs);
+        const double constant = time_modular_pow<ConstantTime>(base, exponent, modulus, runs);
+        (void)std::printf("%8zu %16.3f %16.3f %8.2f\n", bits, variable, constant,
+                          constant / variable);
+    }
+    return 0;
+}
@@ -2,17 +2,48 @@
 #define BIGINTEGER_HPP_goec3csb
 
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <charconv>
 #include <biginteger/hex_conversion.hpp>
+#include <cassert>
+#include <compare>
 #include <concepts>
 #include <cstdint>
+#include <cstring>
+#include <exception>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
 #include <list>
+#include <memory>
 #include <mutex>
+#include <optional>
+#include <ostream>
 #include <random>
+#include <span>
 #include <stdexcept>
 #include <string>
 #include <string_view>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
+// Vector kernels are compiled per instruction set through function attributes and picked at run
+// time, so the library itself needs no -m flags. Define BIGINTEGER_NO_SIMD to build scalar only.
+#if !defined(BIGINTEGER_NO_SIMD) && defined(__GNUC__) && defined(__x86_64__)
+#define BIGINTEGER_SIMD_X86 1
+#define BIGINTEGER_TARGET_AVX2 [[gnu::target("avx2")]]
+#define BIGINTEGER_TARGET_AVX512 [[gnu::target("avx512f,avx512dq,avx512bw,avx512vl")]]
+#include <immintrin.h>
+#elif !defined(BIGINTEGER_NO_SIMD) && defined(__aarch64__) && defined(__ARM_NEON)
+#define BIGINTEGER_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
 namespace Numerics
 {
 
@@ -22,6 +53,9 @@ concept UnsignedIntegral = std::unsigned_integral<T>;
 template <typename T>
 concept SignedIntegral = std::signed_integral<T>;
 
+template <size_t InlineLimbs>
+class BasicBigInteger;
+
 namespace detail
 {
 
@@ -32,6 +66,134 @@ struct NumericConstants
     static constexpr int MAX_POWER_OF_TEN = 999999999;
 };
 
+#ifndef BIGINTEGER_KARATSUBA_THRESHOLD
+#define BIGINTEGER_KARATSUBA_THRESHOLD 24
+#endif
+
+// Squaring halves the schoolbook cost, so its Karatsuba crossover sits higher.
+#ifndef BIGINTEGER_SQR_KARATSUBA_THRESHOLD
+#define BIGINTEGER_SQR_KARATSUBA_THRESHOLD 48
+#endif
+
+#ifndef BIGINTEGER_TOOM3_THRESHOLD
+#define BIGINTEGER_TOOM3_THRESHOLD 192
+#endif
+
+#ifndef BIGINTEGER_TOOM4_THRESHOLD
+#define BIGINTEGER_TOOM4_THRESHOLD 512
+#endif
+
+#ifndef BIGINTEGER_NTT_THRESHOLD
+#define BIGINTEGER_NTT_THRESHOLD 2048
+#endif
+
+#ifndef BIGINTEGER_BURNIKEL_ZIEGLER_THRESHOLD
+#define BIGINTEGER_BURNIKEL_ZIEGLER_THRESHOLD 48
+#endif
+
+#ifndef BIGINTEGER_HALF_GCD_THRESHOLD
+#define BIGINTEGER_HALF_GCD_THRESHOLD 512
+#endif
+
+#ifndef BIGINTEGER_TO_STRING_THRESHOLD
+#define BIGINTEGER_TO_STRING_THRESHOLD 40
+#endif
+
+#ifndef BIGINTEGER_FROM_STRING_THRESHOLD
+#define BIGINTEGER_FROM_STRING_THRESHOLD 40
+#endif
+
+// Operand sizes, in 64-bit limbs, at which multiplication switches to the next algorithm.
+struct MultiplicationThresholds
+{
+    static constexpr size_t KARATSUBA = BIGINTEGER_KARATSUBA_THRESHOLD;
+    static constexpr size_t TOOM3 = BIGINTEGER_TOOM3_THRESHOLD;
+    static constexpr size_t TOOM4 = BIGINTEGER_TOOM4_THRESHOLD;
+    static constexpr size_t NTT = BIGINTEGER_NTT_THRESHOLD;
+    static constexpr size_t SQR_KARATSUBA = BIGINTEGER_SQR_KARATSUBA_THRESHOLD;
+
+    static_assert(KARATSUBA >= 4, "Karatsuba needs at least four limbs to split");
+    static_assert(SQR_KARATSUBA >= 4, "Karatsuba needs at least four limbs to split");
+    static_assert(KARATSUBA <= TOOM3 && TOOM3 <= TOOM4 && TOOM4 <= NTT,
+                  "Thresholds must be non-decreasing");
+};
+
+// Divisor and quotient sizes, in 64-bit limbs, from which division recurses instead of running
+// Algorithm D.
+struct DivisionThresholds
+{
+    static constexpr size_t BURNIKEL_ZIEGLER = BIGINTEGER_BURNIKEL_ZIEGLER_THRESHOLD;
+
+    // Halves of a recursed divisor must keep the two limbs that Algorithm D needs.
+    static_assert(BURNIKEL_ZIEGLER >= 4, "Burnikel-Ziegler needs at least four divisor limbs");
+};
+
+// Operand size, in 64-bit limbs, from which GCDs recurse on leading halves instead of running
+// Lehmer's algorithm over the full numbers.
+struct GcdThresholds
+{
+    static constexpr size_t HALF_GCD = BIGINTEGER_HALF_GCD_THRESHOLD;
+
+    static_assert(HALF_GCD >= 4, "Half-GCD needs at least four limbs to split");
+};
+
+// Value sizes, in 64-bit limbs, from which radix conversion splits the number at powers of the
+// base instead of handling one limb-sized chunk of digits per pass.
+struct ConversionThresholds
+{
+    static constexpr size_t TO_STRING = BIGINTEGER_TO_STRING_THRESHOLD;
+    static constexpr size_t FROM_STRING = BIGINTEGER_FROM_STRING_THRESHOLD;
+
+    static_assert(TO_STRING >= 2, "Radix conversion splits need at least two limbs");
+    static_assert(FROM_STRING >= 2, "Radix conversion splits need at least two limbs");
+};
+
+// Vector instruction sets in increasing order of preference within an architecture.
+enum class SimdLevel
+{
+    Scalar,
+    Neon,
+    Avx2,
+    Avx512
+};
+
+struct CpuFeatures
+{
+    // Best level this CPU and operating system support, detected once. AVX-512 counts only with
+    // the DQ and BW extensions, which the 64-bit and byte kernels rely on.
+    static SimdLevel simd_level() noexcept
+    {
+        static const SimdLevel level = detect();
+        return level;
+    }
+
+    // The requested level, or the best available one when this CPU cannot run it.
+    static SimdLevel supported(SimdLevel requested) noexcept
+    {
+        const SimdLevel best = simd_level();
+        if (requested >= best)
+            return best;
+        // Only x86 has a vector level below its best; NEON never runs there.
+        return requested == SimdLevel::Avx2 ? requested : SimdLevel::Scalar;
+    }
+
+private:
+    static SimdLevel detect() noexcept
+    {
+#if defined(BIGINTEGER_SIMD_X86)
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq") &&
+            __builtin_cpu_supports("avx512bw") && __builtin_cpu_supports("avx512vl"))
+            return SimdLevel::Avx512;
+        if (__builtin_cpu_supports("avx2"))
+            return SimdLevel::Avx2;
+#elif defined(BIGINTEGER_SIMD_NEON)
+        return SimdLevel::Neon;
+#endif
+        return SimdLevel::Scalar;
+    }
+};
+
 namespace dtoa
 {
 
@@ -307,14 +469,9 @@ public:
             for (size_t i = 1; i < digits.size(); ++i)
             {
                 buffer = hex::hex_converter::encode(digits[i]);
-                hex_str = std::string(buffer.begin(), buffer.end());
-
-                while (hex_str.length() < 8)
-                {
-                    hex_str = "0" + hex_str;
-                }
-
-                result += hex_str;
+                if (buffer.size() < 8)
+                    result.append(8 - buffer.size(), '0');
+                result.append(buffer.begin(), buffer.end());
             }
         }
         else if (base == 10)
@@ -324,15 +481,23 @@ public:
                 return is_negative ? "-1000000000" : "1000000000";
             }
 
-            std::vector<uint32_t> temp = digits;
-            std::string temp_result;
-            while (!temp.empty() && !(temp.size() == 1 && temp[0] == 0))
+            // The elements already are base 10^9 digits, most significant first.
+            auto it = std::find_if(digits.begin(), digits.end(), [](uint32_t d) { return d != 0; });
+            if (it == digits.end())
+                return is_negative ? "-0" : "0";
+
+            const size_t lead = decimal_width(*it);
+            const size_t start = result.size();
+            result.resize(start + lead + static_cast<size_t>(digits.end() - it - 1) *
+                                             NumericConstants::DECIMAL_DIGITS_PER_ELEMENT);
+            char* out = result.data() + start;
+            write_decimal(out, *it, lead);
+            out += lead;
+            while (++it != digits.end())
             {
-                uint32_t remainder = divide_by_base(temp, base);
-                temp_result += digit_to_char(remainder);
+                write_decimal(out, *it, NumericConstants::DECIMAL_DIGITS_PER_ELEMENT);
+                out += NumericConstants::DECIMAL_DIGITS_PER_ELEMENT;
             }
-            std::reverse(temp_result.begin(), temp_result.end());
-            result += temp_result;
         }
         else
         {
@@ -341,6 +506,17 @@ public:
             else if (base == 2)
                 result += "0b";
 
+            if (base == 2 || base == 4 || base == 8)
+            {
+                const auto words = to_binary_words(digits);
+                const auto bits =
+                    static_cast<unsigned>(std::countr_zero(static_cast<unsigned>(base)));
+                const size_t start = result.size();
+                result.resize(start + bit_group_count(words.data(), words.size(), bits));
+                write_bit_groups(result.data() + start, words.data(), words.size(), bits);
+                return result;
+            }
+
             std::vector<uint32_t> temp = digits;
             std::string temp_result;
             while (!temp.empty() && !(temp.size() == 1 && temp[0] == 0))
@@ -355,6 +531,131 @@ public:
         return result;
     }
 
+    // Writes value as exactly width decimal digits, zero-padded, to out. Splits into 9-digit
+    // pieces so that the digit loop runs on 32-bit words, emitting two digits per division.
+    static void write_decimal(char* out, uint64_t value, size_t width) noexcept
+    {
+        constexpr uint32_t PIECE = 1000000000;
+        constexpr size_t PIECE_DIGITS = 9;
+        while (width > PIECE_DIGITS)
+        {
+            width -= PIECE_DIGITS;
+            write_decimal_piece(out + width, static_cast<uint32_t>(value % PIECE), PIECE_DIGITS);
+            value /= PIECE;
+        }
+        write_decimal_piece(out, static_cast<uint32_t>(value), width);
+    }
+
+    // Number of decimal digits in value, at least 1.
+    static size_t decimal_width(uint64_t value) noexcept
+    {
+        size_t width = 1;
+        for (; value >= 10; value /= 10)
+            ++width;
+        return width;
+    }
+
+    // Parses count <= 19 decimal digits into value, or returns false if one of them is not a
+    // digit. Full groups of eight are validated and combined in a 64-bit word with three
+    // multiplies instead of one multiply-add per character.
+    static bool read_decimal(const char* in, size_t count, uint64_t& value) noexcept
+    {
+        uint64_t result = 0;
+        if constexpr (std::endian::native == std::endian::little)
+        {
+            for (; count >= 8; in += 8, count -= 8)
+            {
+                uint64_t chunk;
+                std::memcpy(&chunk, in, sizeof(chunk));
+
+                // Every byte must be 0x30-0x39: high nibble 3, and adding 6 must not carry out.
+                if (((chunk & 0xF0F0F0F0F0F0F0F0) |
+                     (((chunk + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4)) !=
+                    0x3333333333333333)
+                    return false;
+
+                // The first character is the lowest byte; fold bytes into pairs, quads, eights.
+                chunk = (chunk & 0x0F0F0F0F0F0F0F0F) * 2561 >> 8;
+                chunk = (chunk & 0x00FF00FF00FF00FF) * 6553601 >> 16;
+                chunk = (chunk & 0x0000FFFF0000FFFF) * 42949672960001 >> 32;
+                result = result * 100000000 + chunk;
+            }
+        }
+
+        for (; count > 0; ++in, --count)
+        {
+            if (*in < '0' || *in > '9')
+                return false;
+            result = result * 10 + static_cast<uint64_t>(*in - '0');
+        }
+
+        value = result;
+        return true;
+    }
+
+    // Number of base 2^bits digits of the magnitude words[0..n), at least 1.
+    template <typename Word>
+    static size_t bit_group_count(const Word* words, size_t n, unsigned bits) noexcept
+    {
+        while (n > 0 && words[n - 1] == 0)
+            --n;
+        if (n == 0)
+            return 1;
+
+        const auto bit_length = n * std::numeric_limits<Word>::digits -
+                                static_cast<size_t>(std::countl_zero(words[n - 1]));
+        return (bit_length + bits - 1) / bits;
+    }
+
+    // Writes the magnitude words[0..n) in base 2^bits, 1 <= bits <= 5, most significant digit
+    // first, and returns the end of the output. Digits are bit groups read straight from the
+    // words, straddling word boundaries where bits does not divide the word size, as in octal.
+    // Groups of eight digits are spread over the bytes of a 64-bit word and converted together.
+    template <typename Word>
+    static char* write_bit_groups(char* out, const Word* words, size_t n, unsigned bits) noexcept
+    {
+        constexpr auto chars = dtoa::DigitChars<uint64_t, dtoa::CharCase::Upper>::get();
+
+        size_t digits = bit_group_count(words, n, bits);
+        for (; digits % 8 != 0; --digits)
+            *out++ = chars[extract_bits(words, n, (digits - 1) * bits, bits)];
+
+        for (; digits != 0; digits -= 8, out += 8)
+        {
+            const uint64_t groups =
+                spread_groups(extract_bits(words, n, (digits - 8) * bits, 8 * bits), bits);
+
+            // Bytes of 10 and up gain the 7 that separates ':' from 'A'.
+            const uint64_t letters = ((groups + 0x7676767676767676) >> 7) & 0x0101010101010101;
+            const uint64_t ascii = groups + 0x3030303030303030 + letters * 7;
+            std::memcpy(out, &ascii, sizeof(ascii));
+        }
+        return out;
+    }
+
+    // Reads the base 2^bits digits [first, last), already validated, into words[0..n), which
+    // must be zero on entry. Bits above words[n - 1] are dropped.
+    template <typename Word>
+    static void read_bit_groups(const char* first, const char* last, Word* words, size_t n,
+                                unsigned bits) noexcept
+    {
+        size_t position = 0;
+        for (; last - first >= 8; position += 8 * bits)
+        {
+            last -= 8;
+            uint64_t chars;
+            std::memcpy(&chars, last, sizeof(chars));
+
+            // Digits keep their low nibble; letters have bit 6 set and map to (c & 0x1F) + 9.
+            const uint64_t letters = (chars >> 6) & 0x0101010101010101;
+            const uint64_t digits = (chars & (0x0F0F0F0F0F0F0F0F | letters << 4)) + letters * 9;
+            deposit_bits(words, n, position, gather_groups(digits, bits));
+        }
+
+        for (; last != first; position += bits)
+            deposit_bits(words, n, position, dtoa::char_to_digit<36, char, uint64_t>(*--last));
+    }
+
     static std::vector<uint32_t> from_string_base(const std::string_view str, int base)
     {
         std::string_view current_str = str;
@@ -439,6 +740,11 @@ public:
             return result;
         }
 
+        if (base == 10)
+            return from_decimal_string(current_str);
+        if (base == 2 || base == 4 || base == 8)
+            return from_bit_groups(current_str, static_cast<unsigned>(base));
+
         std::vector<uint32_t> current_big_digit;
         current_big_digit.push_back(0);
 
@@ -459,6 +765,211 @@ public:
     }
 
 private:
+    // "00", "01", ..., "99".
+    static constexpr std::array<char, 200> DIGIT_PAIRS = [] {
+        std::array<char, 200> pairs{};
+        for (size_t i = 0; i < 100; ++i)
+        {
+            pairs[2 * i] = static_cast<char>('0' + i / 10);
+            pairs[2 * i + 1] = static_cast<char>('0' + i % 10);
+        }
+        return pairs;
+    }();
+
+    static void write_decimal_piece(char* out, uint32_t value, size_t width) noexcept
+    {
+        char* p = out + width;
+        for (; p - out >= 2; value /= 100)
+        {
+            p -= 2;
+            p[0] = DIGIT_PAIRS[2 * (value % 100)];
+            p[1] = DIGIT_PAIRS[2 * (value % 100) + 1];
+        }
+        if (p != out)
+            *--p = static_cast<char>('0' + value % 10);
+    }
+
+    // The elements are base 10^9 digits, so decimal input only needs regrouping: nine
+    // characters per element, counted from the right.
+    static std::vector<uint32_t> from_decimal_string(std::string_view str)
+    {
+        std::string filtered;
+        str = significant_digits(str, 10, filtered);
+        if (str.empty())
+            return {0};
+
+        constexpr size_t PIECE_DIGITS = NumericConstants::DECIMAL_DIGITS_PER_ELEMENT;
+        std::vector<uint32_t> digits((str.size() + PIECE_DIGITS - 1) / PIECE_DIGITS);
+        size_t len = str.size() - (digits.size() - 1) * PIECE_DIGITS;
+        const char* in = str.data();
+        for (auto& digit : digits)
+        {
+            uint64_t value = 0;
+            read_decimal(in, len, value);
+            digit = static_cast<uint32_t>(value);
+            in += len;
+            len = PIECE_DIGITS;
+        }
+        return digits;
+    }
+
+    // Power-of-two bases are read as bit groups into binary words in one pass, then converted to
+    // base 10^9 elements nine decimal digits per division step.
+    static std::vector<uint32_t> from_bit_groups(std::string_view str, unsigned base)
+    {
+        std::string filtered;
+        str = significant_digits(str, base, filtered);
+        if (str.empty())
+            return {0};
+
+        const auto bits = static_cast<unsigned>(std::countr_zero(base));
+        std::vector<uint32_t> words((str.size() * bits + 31) / 32);
+        read_bit_groups(str.data(), str.data() + str.size(), words.data(), words.size(), bits);
+
+        std::vector<uint32_t> digits;
+        for (size_t n = words.size(); n > 0;)
+        {
+            uint64_t remainder = 0;
+            for (size_t i = n; i-- > 0;)
+            {
+                const uint64_t current = remainder << 32 | words[i];
+                words[i] = static_cast<uint32_t>(current / NumericConstants::BASE);
+                remainder = current % NumericConstants::BASE;
+            }
+            digits.push_back(static_cast<uint32_t>(remainder));
+            while (n > 0 && words[n - 1] == 0)
+                --n;
+        }
+        std::reverse(digits.begin(), digits.end());
+        return digits;
+    }
+
+    // The digits of str, base <= 10, without leading zeros. Characters that are not hex digits
+    // are skipped and other hex digits are rejected, as in the general path; filtered holds the
+    // result when anything had to be removed.
+    static std::string_view significant_digits(std::string_view str, uint32_t base,
+                                               std::string& filtered)
+    {
+        const auto in_base = [base](char c) {
+            return c >= '0' && static_cast<uint32_t>(c - '0') < base;
+        };
+        if (!std::all_of(str.begin(), str.end(), in_base))
+        {
+            for (char c : str)
+            {
+                if (in_base(c))
+                    filtered += c;
+                else if (std::isxdigit(static_cast<unsigned char>(c)))
+                    throw std::invalid_argument("Invalid digit for base");
+            }
+            str = filtered;
+        }
+
+        while (!str.empty() && str.front() == '0')
+            str.remove_prefix(1);
+        return str;
+    }
+
+    // Base 10^9 elements, most significant first, as little-endian 32-bit words.
+    static std::vector<uint32_t> to_binary_words(const std::vector<uint32_t>& digits)
+    {
+        std::vector<uint32_t> words;
+        for (uint32_t digit : digits)
+        {
+            uint64_t carry = digit;
+            for (auto& word : words)
+            {
+                const uint64_t current = uint64_t(word) * NumericConstants::BASE + carry;
+                word = static_cast<uint32_t>(current);
+                carry = current >> 32;
+            }
+            if (carry != 0)
+                words.push_back(static_cast<uint32_t>(carry));
+        }
+        return words;
+    }
+
+    // count <= 40 bits of words[0..n) from bit position, zero above the top word.
+    template <typename Word>
+    static uint64_t extract_bits(const Word* words, size_t n, size_t position,
+                                 unsigned count) noexcept
+    {
+        constexpr size_t WORD_BITS = std::numeric_limits<Word>::digits;
+
+        uint64_t value = 0;
+        size_t index = position / WORD_BITS;
+        size_t shift = position % WORD_BITS;
+        for (size_t taken = 0; taken < count && index < n; taken += WORD_BITS - shift, shift = 0)
+            value |= static_cast<uint64_t>(words[index++] >> shift) << taken;
+        return value & ((uint64_t(1) << count) - 1);
+    }
+
+    // ORs value into words[0..n) at bit position.
+    template <typename Word>
+    static void deposit_bits(Word* words, size_t n, size_t position, uint64_t value) noexcept
+    {
+        constexpr size_t WORD_BITS = std::numeric_limits<Word>::digits;
+
+        size_t shift = position % WORD_BITS;
+        for (size_t index = position / WORD_BITS; value != 0 && index < n; ++index, shift = 0)
+        {
+            words[index] |= static_cast<Word>(value << shift);
+            value = WORD_BITS - shift >= 64 ? 0 : value >> (WORD_BITS - shift);
+        }
+    }
+
+    // Mask of the low width bits of every lane-bit lane of a 64-bit word.
+    static constexpr uint64_t lane_mask(unsigned lane, unsigned width) noexcept
+    {
+        const uint64_t low = (uint64_t(1) << width) - 1;
+        return lane == 64 ? low : ~uint64_t(0) / ((uint64_t(1) << lane) - 1) * low;
+    }
+
+    // Splits every 2 * lane bit lane holding 2 * width bits into two lanes of width bits each.
+    static constexpr uint64_t split_lanes(uint64_t value, unsigned lane, unsigned width) noexcept
+    {
+        const uint64_t low = lane_mask(2 * lane, width);
+        const uint64_t high = lane_mask(2 * lane, 2 * width) & ~low;
+        return (value & low) | (value & high) << (lane - width);
+    }
+
+    // Inverse of split_lanes().
+    static constexpr uint64_t join_lanes(uint64_t value, unsigned lane, unsigned width) noexcept
+    {
+        const uint64_t low = lane_mask(2 * lane, width);
+        const uint64_t high = lane_mask(2 * lane, 2 * width) & ~low;
+        return (value & low) | ((value >> (lane - width)) & high);
+    }
+
+    static constexpr uint64_t reverse_bytes(uint64_t value) noexcept
+    {
+        value = (value & 0x00FF00FF00FF00FF) << 8 | ((value >> 8) & 0x00FF00FF00FF00FF);
+        value = (value & 0x0000FFFF0000FFFF) << 16 | ((value >> 16) & 0x0000FFFF0000FFFF);
+        return value << 32 | value >> 32;
+    }
+
+    // Moves the eight bits-wide groups of value into one byte each by halving lanes three times,
+    // then orders the bytes so the most significant group is stored first.
+    static uint64_t spread_groups(uint64_t value, unsigned bits) noexcept
+    {
+        value = split_lanes(value, 32, 4 * bits);
+        value = split_lanes(value, 16, 2 * bits);
+        value = split_lanes(value, 8, bits);
+        if constexpr (std::endian::native == std::endian::little)
+            value = reverse_bytes(value);
+        return value;
+    }
+
+    // Inverse of spread_groups().
+    static uint64_t gather_groups(uint64_t value, unsigned bits) noexcept
+    {
+        if constexpr (std::endian::native == std::endian::little)
+            value = reverse_bytes(value);
+        value = join_lanes(value, 8, bits);
+        value = join_lanes(value, 16, 2 * bits);
+        return join_lanes(value, 32, 4 * bits);
+    }
+
     static uint32_t divide_by_base(std::vector<uint32_t>& digits, uint32_t base)
     {
         uint64_t remainder = 0;
@@ -623,24 +1134,142 @@ public:
     }
 };
 
+// Odd primes below 2^15, sieved at compile time: enough to sieve any range below 2^30 directly
+// and to bootstrap the base primes of larger ones. Kept small because every translation unit
+// that includes this header evaluates it.
+struct SmallPrimes
+{
+    static constexpr uint32_t LIMIT = uint32_t(1) << 15;
+    static constexpr size_t COUNT = 3511;
+
+    static constexpr std::array<uint32_t, COUNT> ODD = [] {
+        // composite[i] describes 2i + 1; raw arrays keep the constant evaluation cheap.
+        bool composite[LIMIT / 2] = {};
+        std::array<uint32_t, COUNT> primes{};
+        size_t count = 0;
+        for (uint32_t i = 1; i < LIMIT / 2; ++i)
+        {
+            if (composite[i])
+                continue;
+            const uint32_t n = 2 * i + 1;
+            primes[count++] = n;
+            for (uint32_t j = n * n / 2; j < LIMIT / 2; j += n)
+                composite[j] = true;
+        }
+        return primes;
+    }();
+
+    static_assert(ODD.back() == 32749, "COUNT must match the primes below LIMIT");
+};
+
+class LimbArithmetic;
+
+template <typename T>
+class BarrettReducer;
+
+template <typename T>
+class MontgomeryReducer;
+
+template <size_t InlineLimbs>
+class MontgomeryContext;
+
+template <size_t InlineLimbs>
+class GreatestCommonDivisor;
+
+template <size_t InlineLimbs>
+class PrimalityTest;
+
+// Exponentiation policies. VariableTime picks the cheapest schedule for each exponent;
+// ConstantTime makes the sequence of operations and memory accesses depend only on the limb
+// counts of the operands, never on the exponent's bits, for use with secret exponents.
+struct VariableTime
+{
+};
+
+struct ConstantTime
+{
+};
+
 class ArithmeticOperations
 {
 public:
+    // Binary (Stein) GCD: shifts and subtractions only, never a division. Always non-negative.
+    template <typename T>
+    static T gcd(T a, T b)
+    {
+        static_assert(std::is_integral_v<T>, "T must be integral type");
+        using U = std::make_unsigned_t<T>;
+
+        U u = magnitude(a);
+        U v = magnitude(b);
+        if (u == 0 || v == 0)
+            return static_cast<T>(u | v);
+
+        const int shift = std::countr_zero(static_cast<U>(u | v));
+        u >>= std::countr_zero(u);
+        do
+        {
+            v >>= std::countr_zero(v);
+            if (u > v)
+                std::swap(u, v);
+            v -= u;
+        } while (v != 0);
+
+        return static_cast<T>(u << shift);
+    }
+
+    // Non-negative gcd(|a|, |b|) by Lehmer's algorithm.
+    template <size_t N>
+    static BasicBigInteger<N> gcd(const BasicBigInteger<N>& a, const BasicBigInteger<N>& b)
+    {
+        return GreatestCommonDivisor<N>::gcd(a, b);
+    }
+
+    // Iterative extended Euclid; returns (g, x, y) with a * x + b * y = g, where g carries the
+    // sign of the last non-zero remainder under truncating division.
     template <typename T>
     static std::tuple<T, T, T> extended_gcd(T a, T b)
     {
         static_assert(std::is_integral_v<T>, "T must be integral type");
-        if (b == T(0))
-            return {a, T(1), T(0)};
+        T x = 1;
+        T y = 0;
+        T next_x = 0;
+        T next_y = 1;
+
+        while (b != T(0))
+        {
+            const T q = a / b;
+            a = std::exchange(b, static_cast<T>(a - q * b));
+            x = std::exchange(next_x, static_cast<T>(x - q * next_x));
+            y = std::exchange(next_y, static_cast<T>(y - q * next_y));
+        }
 
-        auto [gcd, x, y] = extended_gcd(b, a % b);
-        return {gcd, y, x - (a / b) * y};
+        return {a, x, y};
+    }
+
+    // (g, x, y) with a * x + b * y = g = gcd(|a|, |b|) >= 0, by Lehmer's algorithm.
+    template <size_t N>
+    static std::tuple<BasicBigInteger<N>, BasicBigInteger<N>, BasicBigInteger<N>>
+    extended_gcd(const BasicBigInteger<N>& a, const BasicBigInteger<N>& b)
+    {
+        return GreatestCommonDivisor<N>::extended_gcd(a, b);
     }
 
     template <typename T>
     static T modular_multiply(T a, T b, T modulus)
     {
         static_assert(std::is_integral_v<T>, "T must be integral type");
+        if constexpr (native_width<T>)
+        {
+            if (modulus == 0)
+                throw std::domain_error("Modulus must be positive");
+
+            // Signed types follow the built-in % on the exact product: the result takes the sign
+            // of a * b.
+            const auto r = multiply_mod(magnitude(a), magnitude(b), magnitude(modulus));
+            return is_negative(a) != is_negative(b) ? static_cast<T>(0 - r) : static_cast<T>(r);
+        }
+
         T result = 0;
         a %= modulus;
 
@@ -657,84 +1286,462 @@ public:
         return result;
     }
 
+    // Squaring entry point for the exponentiation routines below, so that a dedicated kernel can
+    // serve the base * base step without re-detecting operand aliasing.
     template <typename T>
-    static T modular_inverse(T a, T m)
+    static T modular_square(T a, T modulus)
     {
         static_assert(std::is_integral_v<T>, "T must be integral type");
-        T gcd, x, y;
-        std::tie(gcd, x, y) = extended_gcd(a, m);
-        if (gcd != 1)
-        {
-            return 0;
-        }
-        else
-        {
-            return (x % m + m) % m;
-        }
+        return modular_multiply(a, a, modulus);
     }
 
-    template <typename T>
-    static T modular_pow(T base, T exponent, T modulus)
+    // Non-negative residue of a * b mod modulus; squares when both operands are the same object.
+    template <size_t N>
+    static BasicBigInteger<N> modular_multiply(const BasicBigInteger<N>& a,
+                                               const BasicBigInteger<N>& b,
+                                               const BasicBigInteger<N>& modulus)
     {
-        static_assert(std::is_integral_v<T>, "T must be integral type");
-        T result = 1;
-        base %= modulus;
+        if (&a == &b)
+            return modular_square(a, modulus);
+        return non_negative_mod(a * b, modulus);
+    }
 
-        while (exponent > 0)
+    template <size_t N>
+    static BasicBigInteger<N> modular_square(const BasicBigInteger<N>& a,
+                                             const BasicBigInteger<N>& modulus)
+    {
+        return non_negative_mod(a.square(), modulus);
+    }
+
+    // Sliding-window exponentiation; requires a positive modulus and a non-negative exponent.
+    // Odd moduli run in Montgomery form, even ones through a Barrett reducer. The ConstantTime
+    // policy switches to fixed-window Montgomery exponentiation and requires an odd modulus.
+    template <typename Policy = VariableTime, size_t N>
+    static BasicBigInteger<N> modular_pow(const BasicBigInteger<N>& base,
+                                          const BasicBigInteger<N>& exponent,
+                                          const BasicBigInteger<N>& modulus)
+    {
+        if (modulus.sign() <= 0)
+            throw std::domain_error("Modulus must be positive");
+        if (modulus.is_odd())
+            return MontgomeryContext<N>(modulus).template pow<Policy>(base, exponent);
+        if constexpr (std::is_same_v<Policy, ConstantTime>)
+            throw std::domain_error("Constant-time exponentiation requires an odd modulus");
+        if (exponent.is_negative())
+            throw std::domain_error("Exponent must be non-negative");
+
+        const BarrettReducer<BasicBigInteger<N>> reducer(modulus);
+        const size_t window = exponent_window_size(exponent.bit_length());
+
+        // Odd powers base^1, base^3, ..., base^(2^window - 1).
+        std::vector<BasicBigInteger<N>> table(size_t(1) << (window - 1));
+        table[0] = reducer.reduce(base);
+        if (table.size() > 1)
         {
-            if (exponent & 1)
-            {
-                result = modular_multiply(result, base, modulus);
-            }
-            base = modular_multiply(base, base, modulus);
-            exponent >>= 1;
+            const BasicBigInteger<N> square = reducer.square(table[0]);
+            for (size_t k = 1; k < table.size(); ++k)
+                table[k] = reducer.multiply(table[k - 1], square);
         }
 
+        BasicBigInteger<N> result = reducer.reduce(BasicBigInteger<N>(1));
+        bool started = false;
+        sliding_window(
+            exponent, window,
+            [&] {
+                if (started)
+                    result = reducer.square(result);
+            },
+            [&](size_t odd) {
+                result = started ? reducer.multiply(result, table[odd / 2]) : table[odd / 2];
+                started = true;
+            });
         return result;
     }
 
-    template <typename T>
-    static bool is_prime_miller_rabin(const T& n, int iterations = 20)
+    // Window width for sliding-window exponentiation, trading 2^(w-1) precomputed odd powers
+    // against roughly bits / (w + 1) multiplications.
+    static size_t exponent_window_size(size_t exponent_bits) noexcept
     {
-        static_assert(std::is_integral_v<T>, "T must be integral type");
-        if (n <= 1 || n == 4)
-            return false;
-        if (n <= 3)
-            return true;
-        if (n % 2 == 0)
-            return false;
+        if (exponent_bits > 671)
+            return 6;
+        if (exponent_bits > 239)
+            return 5;
+        if (exponent_bits > 79)
+            return 4;
+        if (exponent_bits > 23)
+            return 3;
+        return 1;
+    }
 
-        T d = n - 1;
-        int r = 0;
-        while ((d & 1) == 0)
+    // Scans exponent from the most significant bit, calling square() once per bit and
+    // multiply(value) after each window, where value is the odd window of at most `window` bits.
+    // The first square() calls precede any multiply() and act on the identity.
+    template <size_t N, typename Square, typename Multiply>
+    static void sliding_window(const BasicBigInteger<N>& exponent, size_t window, Square&& square,
+                               Multiply&& multiply)
+    {
+        size_t i = exponent.bit_length();
+        while (i > 0)
         {
-            d >>= 1;
-            r++;
-        }
-
-        std::random_device rd;
-        std::mt19937_64 gen(rd());
-        std::uniform_int_distribution<T> distrib(2, n - 2);
+            --i;
+            if (!exponent.test_bit(i))
+            {
+                square();
+                continue;
+            }
 
-        for (int i = 0; i < iterations; i++)
-        {
-            T a = distrib(gen);
-            T x = modular_pow(a, d, n);
+            size_t low = i + 1 >= window ? i + 1 - window : 0;
+            while (!exponent.test_bit(low))
+                ++low;
 
-            if (x == 1 || x == n - 1)
+            size_t value = 0;
+            for (size_t j = i + 1; j-- > low;)
+            {
+                square();
+                value = 2 * value + exponent.test_bit(j);
+            }
+            multiply(value);
+            i = low;
+        }
+    }
+
+    // Inverse of a modulo m in [0, m), or 0 when gcd(a, m) != 1. Runs iterative Euclid on
+    // magnitudes, so unsigned types work as well; with hardware division this beats the binary
+    // inverse, whose halvings each need a data-dependent correction.
+    template <typename T>
+    static T modular_inverse(T a, T m)
+    {
+        static_assert(std::is_integral_v<T>, "T must be integral type");
+        if (m == T(0) || is_negative(m))
+            throw std::domain_error("Modulus must be positive");
+
+        using U = std::make_unsigned_t<T>;
+        const U modulus = magnitude(m);
+        U residue = magnitude(a) % modulus;
+        if (is_negative(a) && residue != 0)
+            residue = modulus - residue;
+
+        return static_cast<T>(euclid_inverse(residue, modulus));
+    }
+
+    // Inverse of a modulo m in [0, m), or 0 when gcd(a, m) != 1.
+    template <size_t N>
+    static BasicBigInteger<N> modular_inverse(const BasicBigInteger<N>& a,
+                                              const BasicBigInteger<N>& m)
+    {
+        return GreatestCommonDivisor<N>::modular_inverse(a, m);
+    }
+
+    // Replaces every element with its inverse modulo m in [0, m) by Montgomery's simultaneous
+    // inversion: one modular inverse and 3(n - 1) multiplications. Elements sharing a factor with
+    // m are set to 0 and their indices returned in ascending order.
+    template <typename T>
+    static std::vector<size_t> batch_modular_inverse(std::span<T> values, T m)
+    {
+        static_assert(std::is_unsigned_v<T> && !std::is_same_v<T, bool> && sizeof(T) <= 8,
+                      "T must be native unsigned integral type");
+        if (m == 0)
+            throw std::domain_error("Modulus must be positive");
+
+        const auto coprime = [m](T x) { return gcd(x, m) == 1; };
+        if (m & 1)
+        {
+            // Prefix products stay in Montgomery form while the running inverse stays plain, so
+            // multiplying the two yields plain inverses without a final conversion.
+            const MontgomeryReducer<T> reducer(m);
+            for (T& x : values)
+                x = static_cast<T>(reducer.to_mont(x));
+            return simultaneous_inverse(
+                values,
+                [&reducer](T a, T b) { return static_cast<T>(reducer.mul(a, b)); },
+                [&reducer, m](T product) { return euclid_inverse(reducer.from_mont(product), m); },
+                coprime);
+        }
+
+        for (T& x : values)
+            x %= m;
+        return simultaneous_inverse(
+            values, [m](T a, T b) { return multiply_mod(a, b, m); },
+            [m](T product) { return euclid_inverse(product, m); }, coprime);
+    }
+
+    template <size_t N>
+    static std::vector<size_t> batch_modular_inverse(std::span<BasicBigInteger<N>> values,
+                                                     const BasicBigInteger<N>& m)
+    {
+        using integer_type = BasicBigInteger<N>;
+        if (m.sign() <= 0)
+            throw std::domain_error("Modulus must be positive");
+
+        const auto invert = [&m](const integer_type& product) {
+            return GreatestCommonDivisor<N>::modular_inverse(product, m);
+        };
+        const auto coprime = [&m](const integer_type& x) {
+            return GreatestCommonDivisor<N>::gcd(x, m) == integer_type(1);
+        };
+        if (m.is_odd())
+        {
+            const MontgomeryContext<N> context(m);
+            for (auto& x : values)
+                x = context.to_mont(x);
+            return simultaneous_inverse(
+                values,
+                [&context](const integer_type& a, const integer_type& b) {
+                    return context.mul(a, b);
+                },
+                [&context, &invert](const integer_type& product) {
+                    return invert(context.from_mont(product));
+                },
+                coprime);
+        }
+
+        for (auto& x : values)
+        {
+            x %= m;
+            if (x.is_negative())
+                x += m;
+        }
+        return simultaneous_inverse(
+            values,
+            [&m](const integer_type& a, const integer_type& b) {
+                return modular_multiply(a, b, m);
+            },
+            invert, coprime);
+    }
+
+    template <typename T>
+    static T modular_pow(T base, T exponent, T modulus)
+    {
+        static_assert(std::is_integral_v<T>, "T must be integral type");
+        if constexpr (barrett_reducible<T>)
+        {
+            if (modulus & 1)
+                return MontgomeryReducer<T>(modulus).pow(base, exponent);
+
+            const BarrettReducer<T> reducer(modulus);
+            T result = reducer.reduce(T(1));
+            base = reducer.reduce(base);
+
+            while (exponent > 0)
+            {
+                if (exponent & 1)
+                    result = reducer.multiply(result, base);
+                base = reducer.square(base);
+                exponent >>= 1;
+            }
+
+            return result;
+        }
+
+        T result = 1;
+        base %= modulus;
+
+        while (exponent > 0)
+        {
+            if (exponent & 1)
+            {
+                result = modular_multiply(result, base, modulus);
+            }
+            base = modular_square(base, modulus);
+            exponent >>= 1;
+        }
+
+        return result;
+    }
+
+    // Types up to 64 bits take a deterministic path: trial division by the primes below 128, then
+    // strong probable-prime tests to the bases {2, 7, 61} below 2^32 and Jim Sinclair's seven bases
+    // above, which have no common strong pseudoprime below 2^64. The result is exact, and
+    // iterations only sets the number of random bases for wider types.
+    template <typename T>
+    static bool is_prime_miller_rabin(const T& n, int iterations = 20)
+    {
+        static_assert(std::is_integral_v<T>, "T must be integral type");
+        if constexpr (sizeof(T) <= sizeof(uint64_t))
+        {
+            return !is_negative(n) && is_prime_deterministic(magnitude(n));
+        }
+        else
+        {
+            if (n <= 1 || n == 4)
+                return false;
+            if (n <= 3)
+                return true;
+            if (n % 2 == 0)
+                return false;
+
+            T d = n - 1;
+            int r = 0;
+            while ((d & 1) == 0)
+            {
+                d >>= 1;
+                r++;
+            }
+
+            std::random_device rd;
+            std::mt19937_64 gen(rd());
+            std::uniform_int_distribution<T> distrib(2, n - 2);
+
+            for (int i = 0; i < iterations; i++)
+            {
+                T a = distrib(gen);
+                T x = modular_pow(a, d, n);
+
+                if (x == 1 || x == n - 1)
+                    continue;
+
+                bool composite = true;
+                for (int j = 0; j < r - 1; j++)
+                {
+                    x = modular_square(x, n);
+                    if (x == 1)
+                        return false;
+                    if (x == n - 1)
+                    {
+                        composite = false;
+                        break;
+                    }
+                }
+
+                if (composite)
+                    return false;
+            }
+
+            return true;
+        }
+    }
+
+    // Baillie-PSW probable-prime test. Exact below 2^64, and no composite above is known to pass.
+    template <size_t N>
+    static bool is_prime_baillie_psw(const BasicBigInteger<N>& n)
+    {
+        return PrimalityTest<N>::is_probable_prime(n);
+    }
+
+    // Jacobi symbol (a / n) for positive odd n: 0 when gcd(a, n) != 1, otherwise +1 or -1.
+    template <typename T>
+    static int jacobi_symbol(T a, T n)
+    {
+        static_assert(std::is_integral_v<T>, "T must be integral type");
+        if (is_negative(n) || (n & 1) == 0)
+            throw std::domain_error("Jacobi symbol needs a positive odd modulus");
+
+        using U = std::make_unsigned_t<T>;
+        U m = magnitude(n);
+        U x = static_cast<U>(magnitude(a) % m);
+
+        // (-1 / m) = -1 exactly when m = 3 mod 4.
+        int result = is_negative(a) && (m & 3) == 3 ? -1 : 1;
+        while (x != 0)
+        {
+            const int zeros = std::countr_zero(x);
+            x = static_cast<U>(x >> zeros);
+            if ((zeros & 1) && ((m & 7) == 3 || (m & 7) == 5))
+                result = -result;
+            if ((x & 3) == 3 && (m & 3) == 3)
+                result = -result;
+            std::swap(x, m);
+            x = static_cast<U>(x % m);
+        }
+
+        return m == 1 ? result : 0;
+    }
+
+    template <size_t N>
+    static int jacobi_symbol(const BasicBigInteger<N>& a, const BasicBigInteger<N>& n)
+    {
+        return PrimalityTest<N>::jacobi(a, n);
+    }
+
+private:
+    struct TrialDivisor
+    {
+        uint64_t prime;
+        uint64_t inverse; // prime^-1 mod 2^64
+        uint64_t limit;   // floor((2^64 - 1) / prime)
+    };
+
+    // Odd primes below 128. An odd n is divisible by p exactly when n * p^-1 mod 2^64 <= limit,
+    // which replaces every division of the prefilter with one multiplication.
+    static constexpr std::array<TrialDivisor, 30> TRIAL_DIVISORS = [] {
+        constexpr uint64_t primes[] = {3,  5,  7,  11, 13, 17, 19, 23,  29,  31,
+                                       37, 41, 43, 47, 53, 59, 61, 67,  71,  73,
+                                       79, 83, 89, 97, 101, 103, 107, 109, 113, 127};
+        std::array<TrialDivisor, 30> table{};
+        for (size_t i = 0; i < table.size(); ++i)
+        {
+            uint64_t inverse = primes[i];
+            for (int j = 0; j < 5; ++j)
+                inverse *= 2 - primes[i] * inverse;
+            table[i] = {primes[i], inverse, ~uint64_t(0) / primes[i]};
+        }
+        return table;
+    }();
+
+    static constexpr uint64_t TRIAL_DIVISION_BOUND = 131 * 131;
+
+    template <typename U>
+    static bool is_prime_deterministic(U value) noexcept
+    {
+        const auto n = static_cast<uint64_t>(value);
+        if (n < 2)
+            return false;
+        if ((n & 1) == 0)
+            return n == 2;
+
+        for (const auto& divisor : TRIAL_DIVISORS)
+        {
+            if (n * divisor.inverse <= divisor.limit)
+                return n == divisor.prime;
+        }
+        if (n < TRIAL_DIVISION_BOUND)
+            return true;
+
+        if (n <= std::numeric_limits<uint32_t>::max())
+            return strong_probable_prime<uint64_t>(n, {2, 7, 61});
+        return strong_probable_prime<uint64_t>(n,
+                                               {2, 325, 9375, 28178, 450775, 9780504, 1795265022});
+    }
+
+    // Strong probable-prime test of an odd n > 3 to every base, in Montgomery form. W is a
+    // template parameter so that MontgomeryReducer, defined further down, is found at
+    // instantiation.
+    template <typename W>
+    static bool strong_probable_prime(uint64_t n, std::initializer_list<uint64_t> bases) noexcept
+    {
+        const MontgomeryReducer<W> reducer(static_cast<W>(n));
+        const uint64_t one = reducer.one();
+        const uint64_t minus_one = n - one;
+
+        uint64_t d = n - 1;
+        const int r = std::countr_zero(d);
+        d >>= r;
+
+        for (const uint64_t base : bases)
+        {
+            const uint64_t a = base % n;
+            if (a == 0)
+                continue;
+
+            uint64_t x = reducer.to_mont(static_cast<W>(a));
+            uint64_t power = one;
+            for (uint64_t e = d; e > 0; e >>= 1)
+            {
+                if (e & 1)
+                    power = reducer.mul(power, x);
+                x = reducer.sqr(x);
+            }
+
+            if (power == one || power == minus_one)
                 continue;
 
             bool composite = true;
-            for (int j = 0; j < r - 1; j++)
+            for (int j = 1; j < r && composite; ++j)
             {
-                x = modular_multiply(x, x, n);
-                if (x == 1)
+                power = reducer.sqr(power);
+                if (power == one)
                     return false;
-                if (x == n - 1)
-                {
-                    composite = false;
-                    break;
-                }
+                composite = power != minus_one;
             }
 
             if (composite)
@@ -743,6 +1750,143 @@ public:
 
         return true;
     }
+
+    // Unsigned types up to one limb exponentiate through MontgomeryReducer for odd moduli and
+    // BarrettReducer otherwise; signed types multiply step by step, which preserves their sign
+    // conventions.
+    template <typename T>
+    static constexpr bool barrett_reducible =
+        std::unsigned_integral<T> && !std::same_as<T, bool> && sizeof(T) <= sizeof(uint64_t);
+
+    // Integer types whose products fit in two limbs; wider ones keep the double-and-add loop.
+    template <typename T>
+    static constexpr bool native_width =
+        std::is_integral_v<T> && !std::same_as<T, bool> && sizeof(T) <= sizeof(uint64_t);
+
+    // a * b mod m for m != 0: one widening multiply and one double-limb division, or a single
+    // 64-bit product for types up to 32 bits. Ops is a template parameter so that
+    // LimbArithmetic, defined further down, is looked up at instantiation.
+    template <typename U, typename Ops = LimbArithmetic>
+    static U multiply_mod(U a, U b, U m) noexcept
+    {
+        if constexpr (sizeof(U) <= sizeof(uint32_t))
+        {
+            return static_cast<U>(uint64_t(a) * b % m);
+        }
+        else
+        {
+            typename Ops::limb_type high;
+            const auto low = Ops::mul_wide(a % m, b, high);
+            typename Ops::limb_type remainder;
+            Ops::div_wide(high, low, m, remainder);
+            return static_cast<U>(remainder);
+        }
+    }
+
+    template <size_t N>
+    static BasicBigInteger<N> non_negative_mod(const BasicBigInteger<N>& value,
+                                               const BasicBigInteger<N>& modulus)
+    {
+        BasicBigInteger<N> result = value % modulus;
+        if (result.is_negative())
+            result += modulus;
+        return result;
+    }
+
+    template <typename T>
+    static constexpr bool is_negative(T value) noexcept
+    {
+        if constexpr (std::is_signed_v<T>)
+            return value < 0;
+        else
+            return false;
+    }
+
+    // |value| as the unsigned type, well defined for the most negative value as well.
+    template <typename T>
+    static std::make_unsigned_t<T> magnitude(T value) noexcept
+    {
+        using U = std::make_unsigned_t<T>;
+        if constexpr (std::is_signed_v<T>)
+            return value < 0 ? static_cast<U>(U(0) - static_cast<U>(value)) : static_cast<U>(value);
+        else
+            return value;
+    }
+
+    // Extended Euclid for a in [0, m) tracking only the magnitude of a's coefficient, whose
+    // sign alternates with every step.
+    template <typename U>
+    static U euclid_inverse(U a, U m) noexcept
+    {
+        U r0 = m;
+        U r1 = a;
+        U t0 = 0;
+        U t1 = 1;
+        bool positive = false;
+        while (r1 != 0)
+        {
+            const U q = r0 / r1;
+            r0 = std::exchange(r1, static_cast<U>(r0 - q * r1));
+            t0 = std::exchange(t1, static_cast<U>(t0 + q * t1));
+            positive = !positive;
+        }
+
+        if (r0 != 1 || m == 1)
+            return 0;
+        return positive ? t0 : static_cast<U>(m - t0);
+    }
+
+    // Montgomery's trick over residues in whatever form multiply works in: multiply must map two
+    // such residues to a third and a plain residue times one to a plain residue, while invert maps
+    // the product of units to its plain inverse, or 0 when it is not a unit.
+    template <typename T, typename Multiply, typename Invert, typename Coprime>
+    static std::vector<size_t> simultaneous_inverse(std::span<T> values, Multiply&& multiply,
+                                                    Invert&& invert, Coprime&& coprime)
+    {
+        const T zero{};
+        std::vector<T> products;
+        products.reserve(values.size());
+
+        T inverse{};
+        for (bool screened = false;; screened = true)
+        {
+            products.clear();
+            for (const T& x : values)
+                if (x != zero)
+                    products.push_back(products.empty() ? x : multiply(products.back(), x));
+            if (products.empty())
+                break;
+
+            inverse = invert(products.back());
+            if (inverse != zero || screened)
+                break;
+
+            // Only a composite modulus gets here; drop the elements sharing a factor with it.
+            for (T& x : values)
+                if (x != zero && !coprime(x))
+                    x = zero;
+        }
+
+        size_t k = products.size();
+        for (size_t i = values.size(); i-- > 0 && k > 0;)
+        {
+            if (values[i] == zero)
+                continue;
+            if (--k == 0)
+            {
+                values[i] = std::move(inverse);
+                break;
+            }
+            T x = std::exchange(values[i], multiply(inverse, products[k - 1]));
+            inverse = multiply(inverse, x);
+        }
+
+        std::vector<size_t> rejected;
+        for (size_t i = 0; i < values.size(); ++i)
+            if (values[i] == zero)
+                rejected.push_back(i);
+        return rejected;
+    }
 };
 
 class NewtonRaphsonDivision
@@ -778,6 +1922,155 @@ public:
 
         return {int_quotient, remainder};
     }
+
+    // Below this many bits the starting reciprocal comes from one long division.
+    static constexpr size_t RECIPROCAL_BASE_BITS = 2048;
+
+    // floor(2^precision / |divisor|), carrying the divisor's sign.
+    template <size_t N>
+    static BasicBigInteger<N> reciprocal(const BasicBigInteger<N>& divisor, size_t precision)
+    {
+        if (divisor.is_zero())
+            throw std::domain_error("Division by zero");
+
+        const BasicBigInteger<N> magnitude = divisor.abs();
+        const size_t bits = magnitude.bit_length();
+
+        // 2^p / d = 2^(p + s) / (d * 2^s), so a wide precision becomes a normalized reciprocal
+        // of the shifted divisor, and a narrow one is a truncation of the normalized reciprocal.
+        const BasicBigInteger<N> result =
+            precision < 2 * bits ? normalized_reciprocal(magnitude) >> (2 * bits - precision)
+                                 : normalized_reciprocal(magnitude << (precision - 2 * bits));
+        return divisor.is_negative() ? -result : result;
+    }
+
+    // Exact quotient and remainder, truncated toward zero like BigInteger's operator/ and
+    // operator%. Use Reciprocal directly to divide repeatedly by the same divisor.
+    template <size_t N>
+    static std::pair<BasicBigInteger<N>, BasicBigInteger<N>>
+    divide_with_remainder(const BasicBigInteger<N>& dividend, const BasicBigInteger<N>& divisor)
+    {
+        return Reciprocal<N>(divisor).divide_with_remainder(dividend);
+    }
+
+    // Precomputed fixed-point reciprocal of one divisor. The divisor is shifted to a whole number
+    // of limbs L, and dividends are consumed L limbs at a time, each block costing two
+    // multiplications and at most a few corrections instead of a full division.
+    template <size_t N>
+    class Reciprocal
+    {
+        using integer_type = BasicBigInteger<N>;
+
+    public:
+        explicit Reciprocal(const integer_type& divisor) : divisor_(divisor)
+        {
+            if (divisor.is_zero())
+                throw std::domain_error("Division by zero");
+
+            const size_t bits = divisor.bit_length();
+            block_limbs_ = (bits + integer_type::LIMB_BITS - 1) / integer_type::LIMB_BITS;
+            shift_ = block_limbs_ * integer_type::LIMB_BITS - bits;
+            normalized_ = divisor.abs() << shift_;
+            reciprocal_ = normalized_reciprocal(normalized_);
+        }
+
+        [[nodiscard]] const integer_type& divisor() const noexcept { return divisor_; }
+
+        [[nodiscard]] std::pair<integer_type, integer_type>
+        divide_with_remainder(const integer_type& dividend) const
+        {
+            const size_t block_bits = block_limbs_ * integer_type::LIMB_BITS;
+            const integer_type shifted = dividend.abs() << shift_;
+            const auto limbs = shifted.limbs();
+            const size_t blocks = (limbs.size() + block_limbs_ - 1) / block_limbs_;
+
+            typename integer_type::storage_type quotient;
+            quotient.resize(blocks * block_limbs_);
+            integer_type remainder;
+
+            // Each block value x = remainder * B^L + next limbs stays below d * B^L, so the
+            // estimate floor(floor(x / 2^(n-1)) * v / 2^(n+1)) undershoots the block quotient
+            // by at most two.
+            for (size_t block = blocks; block-- > 0;)
+            {
+                const size_t begin = block * block_limbs_;
+                const size_t count = std::min(block_limbs_, limbs.size() - begin);
+
+                const integer_type x = (remainder << block_bits) +
+                                       integer_type::from_limbs(limbs.subspan(begin, count));
+                integer_type q = ((x >> (block_bits - 1)) * reciprocal_) >> (block_bits + 1);
+                remainder = x - q * normalized_;
+                while (remainder >= normalized_)
+                {
+                    remainder -= normalized_;
+                    ++q;
+                }
+
+                std::copy(q.limbs().begin(), q.limbs().end(), quotient.begin() + begin);
+            }
+
+            remainder >>= shift_;
+            return {integer_type::from_limbs({quotient.data(), quotient.size()},
+                                             dividend.is_negative() != divisor_.is_negative()),
+                    dividend.is_negative() ? -remainder : remainder};
+        }
+
+    private:
+        integer_type divisor_;
+        integer_type normalized_;
+        integer_type reciprocal_;
+        size_t block_limbs_ = 0;
+        size_t shift_ = 0;
+    };
+
+private:
+    // floor(2^(2n) / d) for a positive d of bit length n. Each Newton step lifts an approximation
+    // v of 2^(m+h) / d_m, where d_m holds the top m bits of d and h is about m / 2, to twice the
+    // precision through the residual e = 2^(m+h) - v * d_m:
+    //     v' = v * 2^(m-h) + v * e / 2^(2h).
+    // The guard bits keep the accumulated error to a few units, which the final correction
+    // against d removes exactly.
+    template <size_t N>
+    static BasicBigInteger<N> normalized_reciprocal(const BasicBigInteger<N>& d)
+    {
+        using integer_type = BasicBigInteger<N>;
+        const size_t n = d.bit_length();
+
+        std::vector<size_t> precisions;
+        size_t bits = n;
+        while (bits > RECIPROCAL_BASE_BITS)
+        {
+            precisions.push_back(bits);
+            bits = bits / 2 + 2;
+        }
+
+        integer_type v = (integer_type(1) << (2 * bits)) / (d >> (n - bits));
+
+        for (auto it = precisions.rbegin(); it != precisions.rend(); ++it)
+        {
+            const size_t m = *it;
+            const integer_type residual = (integer_type(1) << (m + bits)) - v * (d >> (n - m));
+
+            // Bits of the residual below 2^(h-2) move v' by less than one unit.
+            const size_t dropped = bits - 2;
+            v = (v << (m - bits)) + ((v * (residual >> dropped)) >> (2 * bits - dropped));
+            bits = m;
+        }
+
+        integer_type error = (integer_type(1) << (2 * n)) - v * d;
+        while (error.is_negative())
+        {
+            --v;
+            error += d;
+        }
+        while (error >= d)
+        {
+            ++v;
+            error -= d;
+        }
+
+        return v;
+    }
 };
 
 template <typename T>
@@ -787,6 +2080,27 @@ public:
     static constexpr size_t BLOCK_SIZE = 4096;
     static constexpr size_t ALIGNMENT = 64;
 
+    struct AllocationCounters
+    {
+        size_t allocations;
+        size_t deallocations;
+        size_t bytes_allocated;
+    };
+
+    static AllocationCounters allocation_counters() noexcept
+    {
+        return {allocations_.load(std::memory_order_relaxed),
+                deallocations_.load(std::memory_order_relaxed),
+                bytes_allocated_.load(std::memory_order_relaxed)};
+    }
+
+    static void reset_allocation_counters() noexcept
+    {
+        allocations_.store(0, std::memory_order_relaxed);
+        deallocations_.store(0, std::memory_order_relaxed);
+        bytes_allocated_.store(0, std::memory_order_relaxed);
+    }
+
     static T* allocate_aligned(size_t n)
     {
         size_t size = n * sizeof(T);
@@ -806,11 +2120,16 @@ public:
         }
 #endif
 
+        allocations_.fetch_add(1, std::memory_order_relaxed);
+        bytes_allocated_.fetch_add(size, std::memory_order_relaxed);
         return static_cast<T*>(ptr);
     }
 
     static void deallocate_aligned(T* ptr)
     {
+        if (ptr)
+            deallocations_.fetch_add(1, std::memory_order_relaxed);
+
 #ifdef _WIN32
         _aligned_free(ptr);
 #else
@@ -888,9 +2207,5247 @@ public:
 
         friend struct BlockDeleter;
     };
+
+private:
+    static inline std::atomic<size_t> allocations_{0};
+    static inline std::atomic<size_t> deallocations_{0};
+    static inline std::atomic<size_t> bytes_allocated_{0};
 };
 
-} // namespace detail
+// Limb vector that keeps up to InlineLimbs elements inside the object and only moves to
+// MemoryManager-backed heap storage once that capacity is exceeded.
+template <size_t InlineLimbs>
+class LimbStorage
+{
+    using memory = MemoryManager<uint64_t>;
+
+public:
+    using value_type = uint64_t;
+    using size_type = size_t;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using pointer = value_type*;
+    using const_pointer = const value_type*;
+    using iterator = pointer;
+    using const_iterator = const_pointer;
+
+    static constexpr size_type inline_capacity = InlineLimbs;
+
+    LimbStorage() noexcept = default;
+
+    LimbStorage(const LimbStorage& other) { assign(other.begin(), other.end()); }
+
+    LimbStorage(LimbStorage&& other) noexcept { take(other); }
+
+    LimbStorage& operator=(const LimbStorage& other)
+    {
+        if (this != &other)
+            assign(other.begin(), other.end());
+        return *this;
+    }
+
+    LimbStorage& operator=(LimbStorage&& other) noexcept
+    {
+        if (this != &other)
+        {
+            release();
+            take(other);
+        }
+        return *this;
+    }
+
+    ~LimbStorage() { release(); }
+
+    [[nodiscard]] size_type size() const noexcept { return size_; }
+
+    [[nodiscard]] size_type capacity() const noexcept { return capacity_; }
+
+    [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+
+    [[nodiscard]] bool is_inline() const noexcept { return data_ == inline_.data(); }
+
+    [[nodiscard]] pointer data() noexcept { return data_; }
+
+    [[nodiscard]] const_pointer data() const noexcept { return data_; }
+
+    [[nodiscard]] reference operator[](size_type pos) noexcept { return data_[pos]; }
+
+    [[nodiscard]] const_reference operator[](size_type pos) const noexcept { return data_[pos]; }
+
+    [[nodiscard]] reference back() noexcept { return data_[size_ - 1]; }
+
+    [[nodiscard]] const_reference back() const noexcept { return data_[size_ - 1]; }
+
+    [[nodiscard]] iterator begin() noexcept { return data_; }
+
+    [[nodiscard]] const_iterator begin() const noexcept { return data_; }
+
+    [[nodiscard]] iterator end() noexcept { return data_ + size_; }
+
+    [[nodiscard]] const_iterator end() const noexcept { return data_ + size_; }
+
+    void clear() noexcept { size_ = 0; }
+
+    void reserve(size_type n)
+    {
+        if (n <= capacity_)
+            return;
+
+        const size_type new_capacity = std::max(n, capacity_ * 2);
+        pointer new_data = memory::allocate_aligned(new_capacity);
+        std::copy(data_, data_ + size_, new_data);
+
+        release();
+        data_ = new_data;
+        capacity_ = new_capacity;
+    }
+
+    // Like resize() but leaves new limbs uninitialized, for buffers that are written before use.
+    void resize_for_overwrite(size_type n)
+    {
+        reserve(n);
+        size_ = n;
+    }
+
+    // New limbs are zero-filled.
+    void resize(size_type n)
+    {
+        reserve(n);
+        if (n > size_)
+            std::fill(data_ + size_, data_ + n, value_type(0));
+        size_ = n;
+    }
+
+    void push_back(value_type value)
+    {
+        reserve(size_ + 1);
+        data_[size_++] = value;
+    }
+
+    template <typename InputIt>
+    void assign(InputIt first, InputIt last)
+    {
+        const auto n = static_cast<size_type>(std::distance(first, last));
+        size_ = 0;
+        reserve(n);
+        std::copy(first, last, data_);
+        size_ = n;
+    }
+
+    friend bool operator==(const LimbStorage& lhs, const LimbStorage& rhs) noexcept
+    {
+        return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+
+private:
+    std::array<value_type, InlineLimbs> inline_;
+    pointer data_ = inline_.data();
+    size_type size_ = 0;
+    size_type capacity_ = InlineLimbs;
+
+    void release() noexcept
+    {
+        if (!is_inline())
+            memory::deallocate_aligned(data_);
+        data_ = inline_.data();
+        capacity_ = InlineLimbs;
+    }
+
+    void take(LimbStorage& other) noexcept
+    {
+        if (other.is_inline())
+        {
+            // The min is a no-op for an inline source, but it lets the compiler see the copy
+            // stays inside the inline array.
+            assert(other.size_ <= InlineLimbs);
+            std::copy_n(other.inline_.data(), std::min(other.size_, InlineLimbs), inline_.data());
+            data_ = inline_.data();
+            capacity_ = InlineLimbs;
+        }
+        else
+        {
+            data_ = other.data_;
+            capacity_ = other.capacity_;
+            other.data_ = other.inline_.data();
+            other.capacity_ = InlineLimbs;
+        }
+        size_ = other.size_;
+        other.size_ = 0;
+    }
+};
+
+class LimbArithmetic
+{
+public:
+    using limb_type = uint64_t;
+    static constexpr int LIMB_BITS = 64;
+
+#if defined(__SIZEOF_INT128__)
+    __extension__ using double_limb_type = unsigned __int128;
+#endif
+
+    static limb_type mul_wide(limb_type a, limb_type b, limb_type& high) noexcept
+    {
+#if defined(__SIZEOF_INT128__)
+        const auto product = static_cast<double_limb_type>(a) * b;
+        high = static_cast<limb_type>(product >> LIMB_BITS);
+        return static_cast<limb_type>(product);
+#else
+        const limb_type a_lo = a & 0xFFFFFFFF, a_hi = a >> 32;
+        const limb_type b_lo = b & 0xFFFFFFFF, b_hi = b >> 32;
+
+        const limb_type lo_lo = a_lo * b_lo;
+        const limb_type hi_lo = a_hi * b_lo;
+        const limb_type lo_hi = a_lo * b_hi;
+        const limb_type hi_hi = a_hi * b_hi;
+
+        const limb_type cross = (lo_lo >> 32) + (hi_lo & 0xFFFFFFFF) + lo_hi;
+        high = hi_hi + (hi_lo >> 32) + (cross >> 32);
+        return (cross << 32) | (lo_lo & 0xFFFFFFFF);
+#endif
+    }
+
+    // Divides (high:low) by divisor; requires high < divisor so the quotient fits in one limb.
+    static limb_type div_wide(limb_type high, limb_type low, limb_type divisor,
+                              limb_type& remainder) noexcept
+    {
+#if defined(__x86_64__) && defined(__GNUC__)
+        // A single divq; the compiler would call the full 128-bit division routine instead.
+        limb_type quotient;
+        __asm__("divq %[divisor]"
+                : "=a"(quotient), "=d"(remainder)
+                : [divisor] "rm"(divisor), "a"(low), "d"(high));
+        return quotient;
+#elif defined(__SIZEOF_INT128__)
+        const auto dividend = (static_cast<double_limb_type>(high) << LIMB_BITS) | low;
+        remainder = static_cast<limb_type>(dividend % divisor);
+        return static_cast<limb_type>(dividend / divisor);
+#else
+        const int shift = BitManipulation::count_leading_zeros(divisor);
+        if (shift != 0)
+        {
+            divisor <<= shift;
+            high = (high << shift) | (low >> (LIMB_BITS - shift));
+            low <<= shift;
+        }
+
+        const limb_type d_hi = divisor >> 32, d_lo = divisor & 0xFFFFFFFF;
+        const limb_type l_hi = low >> 32, l_lo = low & 0xFFFFFFFF;
+
+        limb_type q_hi = high / d_hi;
+        limb_type rhat = high % d_hi;
+        while (q_hi >> 32 || q_hi * d_lo > ((rhat << 32) | l_hi))
+        {
+            --q_hi;
+            rhat += d_hi;
+            if (rhat >> 32)
+                break;
+        }
+
+        const limb_type mid = (high << 32) + l_hi - q_hi * divisor;
+
+        limb_type q_lo = mid / d_hi;
+        rhat = mid % d_hi;
+        while (q_lo >> 32 || q_lo * d_lo > ((rhat << 32) | l_lo))
+        {
+            --q_lo;
+            rhat += d_hi;
+            if (rhat >> 32)
+                break;
+        }
+
+        remainder = ((mid << 32) + l_lo - q_lo * divisor) >> shift;
+        return (q_hi << 32) | q_lo;
+#endif
+    }
+
+    static size_t normalized_size(const limb_type* a, size_t n) noexcept
+    {
+        while (n > 0 && a[n - 1] == 0)
+            --n;
+        return n;
+    }
+
+    static int compare(const limb_type* a, const limb_type* b, size_t n) noexcept
+    {
+        while (n-- > 0)
+        {
+            if (a[n] != b[n])
+                return a[n] < b[n] ? -1 : 1;
+        }
+        return 0;
+    }
+
+    static int compare(const limb_type* a, size_t an, const limb_type* b, size_t bn) noexcept
+    {
+        if (an != bn)
+            return an < bn ? -1 : 1;
+        return compare(a, b, an);
+    }
+
+    // r[0..n) = a[0..n) + b[0..n); r may alias a or b. Returns the carry out.
+    static limb_type add_n(limb_type* r, const limb_type* a, const limb_type* b, size_t n) noexcept
+    {
+        limb_type carry = 0;
+        for (size_t i = 0; i < n; ++i)
+        {
+            const limb_type sum = a[i] + carry;
+            carry = sum < carry;
+            r[i] = sum + b[i];
+            carry += r[i] < sum;
+        }
+        return carry;
+    }
+
+    static limb_type add_1(limb_type* r, const limb_type* a, size_t n, limb_type b) noexcept
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            r[i] = a[i] + b;
+            b = r[i] < b;
+        }
+        return b;
+    }
+
+    // r[0..an) = a[0..an) + b[0..bn) with an >= bn.
+    static limb_type add(limb_type* r, const limb_type* a, size_t an, const limb_type* b,
+                         size_t bn) noexcept
+    {
+        const limb_type carry = add_n(r, a, b, bn);
+        return add_1(r + bn, a + bn, an - bn, carry);
+    }
+
+    // r[0..n) = a[0..n) - b[0..n); r may alias a or b. Returns the borrow out.
+    static limb_type sub_n(limb_type* r, const limb_type* a, const limb_type* b, size_t n) noexcept
+    {
+        limb_type borrow = 0;
+        for (size_t i = 0; i < n; ++i)
+        {
+            const limb_type diff = a[i] - b[i];
+            const limb_type next_borrow = (a[i] < b[i]) | (diff < borrow);
+            r[i] = diff - borrow;
+            borrow = next_borrow;
+        }
+        return borrow;
+    }
+
+    static limb_type sub_1(limb_type* r, const limb_type* a, size_t n, limb_type b) noexcept
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            const limb_type ai = a[i];
+            r[i] = ai - b;
+            b = ai < b;
+        }
+        return b;
+    }
+
+    // r[0..an) = a[0..an) - b[0..bn) with an >= bn.
+    static limb_type sub(limb_type* r, const limb_type* a, size_t an, const limb_type* b,
+                         size_t bn) noexcept
+    {
+        const limb_type borrow = sub_n(r, a, b, bn);
+        return sub_1(r + bn, a + bn, an - bn, borrow);
+    }
+
+    // r[0..n) = a[0..n) * b. Returns the high limb.
+    static limb_type mul_1(limb_type* r, const limb_type* a, size_t n, limb_type b) noexcept
+    {
+        limb_type carry = 0;
+        for (size_t i = 0; i < n; ++i)
+        {
+            limb_type high;
+            const limb_type low = mul_wide(a[i], b, high);
+            r[i] = low + carry;
+            carry = high + (r[i] < low);
+        }
+        return carry;
+    }
+
+    // r[0..n) += a[0..n) * b. Returns the carry limb.
+    static limb_type addmul_1(limb_type* r, const limb_type* a, size_t n, limb_type b) noexcept
+    {
+        limb_type carry = 0;
+        for (size_t i = 0; i < n; ++i)
+        {
+            limb_type high;
+            limb_type low = mul_wide(a[i], b, high);
+            low += carry;
+            high += low < carry;
+            r[i] += low;
+            carry = high + (r[i] < low);
+        }
+        return carry;
+    }
+
+    // r[0..n) -= a[0..n) * b. Returns the borrow limb.
+    static limb_type submul_1(limb_type* r, const limb_type* a, size_t n, limb_type b) noexcept
+    {
+        limb_type borrow = 0;
+        for (size_t i = 0; i < n; ++i)
+        {
+            limb_type high;
+            limb_type low = mul_wide(a[i], b, high);
+            low += borrow;
+            high += low < borrow;
+            const limb_type ri = r[i];
+            r[i] = ri - low;
+            borrow = high + (ri < low);
+        }
+        return borrow;
+    }
+
+    // r[0..n) = a[0..n) << count for 0 < count < LIMB_BITS. Returns the bits shifted out.
+    static limb_type lshift(limb_type* r, const limb_type* a, size_t n, unsigned count) noexcept
+    {
+        limb_type out = 0;
+        for (size_t i = n; i-- > 0;)
+        {
+            const limb_type ai = a[i];
+            if (i + 1 == n)
+                out = ai >> (LIMB_BITS - count);
+            r[i] = (ai << count) | (i > 0 ? a[i - 1] >> (LIMB_BITS - count) : 0);
+        }
+        return out;
+    }
+
+    // r[0..n) = a[0..n) >> count for 0 < count < LIMB_BITS. Returns the bits shifted out,
+    // left-aligned in the limb.
+    static limb_type rshift(limb_type* r, const limb_type* a, size_t n, unsigned count) noexcept
+    {
+        if (n == 0)
+            return 0;
+
+        const limb_type out = a[0] << (LIMB_BITS - count);
+        for (size_t i = 0; i < n; ++i)
+        {
+            r[i] = (a[i] >> count) | (i + 1 < n ? a[i + 1] << (LIMB_BITS - count) : 0);
+        }
+        return out;
+    }
+
+    // r[0..an+bn) = a[0..an) * b[0..bn); r must not overlap a or b.
+    static void mul_basecase(limb_type* r, const limb_type* a, size_t an, const limb_type* b,
+                             size_t bn) noexcept
+    {
+        r[an] = mul_1(r, a, an, b[0]);
+        for (size_t i = 1; i < bn; ++i)
+        {
+            r[an + i] = addmul_1(r + i, a, an, b[i]);
+        }
+    }
+
+    // r[0..2n) = a[0..n)^2; r must not overlap a. Each cross product a[i]*a[j] is formed once and
+    // doubled, so this costs about half of mul_basecase(r, a, n, a, n).
+    static void sqr_basecase(limb_type* r, const limb_type* a, size_t n) noexcept
+    {
+        r[0] = 0;
+        r[2 * n - 1] = 0;
+        if (n > 1)
+        {
+            r[n] = mul_1(r + 1, a + 1, n - 1, a[0]);
+            for (size_t i = 1; i + 1 < n; ++i)
+            {
+                r[n + i] = addmul_1(r + 2 * i + 1, a + i + 1, n - i - 1, a[i]);
+            }
+            lshift(r, r, 2 * n, 1);
+        }
+
+        limb_type carry = 0;
+        for (size_t i = 0; i < n; ++i)
+        {
+            limb_type high;
+            const limb_type low = mul_wide(a[i], a[i], high);
+
+            limb_type sum = r[2 * i] + low;
+            limb_type next = sum < low;
+            r[2 * i] = sum + carry;
+            next += r[2 * i] < carry;
+
+            sum = r[2 * i + 1] + high;
+            carry = sum < high;
+            r[2 * i + 1] = sum + next;
+            carry += r[2 * i + 1] < next;
+        }
+    }
+
+    // q[0..n) = a[0..n) / d, returns a mod d. q may alias a.
+    static limb_type divrem_1(limb_type* q, const limb_type* a, size_t n, limb_type d) noexcept
+    {
+        limb_type remainder = 0;
+        for (size_t i = n; i-- > 0;)
+        {
+            q[i] = div_wide(remainder, a[i], d, remainder);
+        }
+        return remainder;
+    }
+
+    // Knuth's Algorithm D. q[0..an-bn+1) = a / b, r[0..bn) = a mod b.
+    // Requires an >= bn >= 2 and b[bn-1] != 0; q and r must not overlap the inputs.
+    static void divrem(limb_type* q, limb_type* r, const limb_type* a, size_t an,
+                       const limb_type* b, size_t bn)
+    {
+        const unsigned shift =
+            static_cast<unsigned>(BitManipulation::count_leading_zeros(b[bn - 1]));
+
+        LimbStorage<32> scratch;
+        scratch.resize(an + 1 + bn);
+        limb_type* u = scratch.data();
+        limb_type* v = u + an + 1;
+
+        if (shift != 0)
+        {
+            lshift(v, b, bn, shift);
+            u[an] = lshift(u, a, an, shift);
+        }
+        else
+        {
+            std::copy(b, b + bn, v);
+            std::copy(a, a + an, u);
+            u[an] = 0;
+        }
+
+        divrem_normalized(q, u, an + 1, v, bn);
+
+        if (shift != 0)
+            rshift(r, u, bn, shift);
+        else
+            std::copy(u, u + bn, r);
+    }
+
+    // Algorithm D on a normalized divisor (top bit of v[bn-1] set), in place: q[0..un-bn) receives
+    // the low quotient limbs and u[0..bn) the remainder. The top bn limbs of u may exceed v, in
+    // which case v is subtracted from them first and 1 is returned as the quotient's top limb.
+    // Requires un >= bn >= 2.
+    static limb_type divrem_normalized(limb_type* q, limb_type* u, size_t un, const limb_type* v,
+                                       size_t bn) noexcept
+    {
+        limb_type* high = u + un - bn;
+        const limb_type qh = compare(high, v, bn) >= 0;
+        if (qh)
+            sub_n(high, high, v, bn);
+
+        const limb_type v1 = v[bn - 1];
+        const limb_type v0 = v[bn - 2];
+
+        for (size_t j = un - bn; j-- > 0;)
+        {
+            const limb_type u2 = u[j + bn];
+            const limb_type u1 = u[j + bn - 1];
+            const limb_type u0 = u[j + bn - 2];
+
+            limb_type qhat;
+            limb_type rhat;
+            bool rhat_overflow = false;
+
+            if (u2 >= v1)
+            {
+                qhat = ~limb_type(0);
+                rhat = u1 + v1;
+                rhat_overflow = rhat < u1;
+            }
+            else
+            {
+                qhat = div_wide(u2, u1, v1, rhat);
+            }
+
+            while (!rhat_overflow)
+            {
+                limb_type product_high;
+                const limb_type product_low = mul_wide(qhat, v0, product_high);
+                if (product_high < rhat || (product_high == rhat && product_low <= u0))
+                    break;
+
+                --qhat;
+                rhat += v1;
+                rhat_overflow = rhat < v1;
+            }
+
+            const limb_type borrow = submul_1(u + j, v, bn, qhat);
+            const limb_type top = u[j + bn];
+            u[j + bn] = top - borrow;
+
+            if (top < borrow)
+            {
+                --qhat;
+                u[j + bn] += add_n(u + j, u + j, v, bn);
+            }
+
+            q[j] = qhat;
+        }
+
+        return qh;
+    }
+};
+
+// Radix conversion of magnitudes held in limb spans, shaped like std::to_chars and
+// std::from_chars: no sign, no base prefix, digits past 9 as letters. Power-of-two bases map
+// digits onto bit groups directly, in linear time and without scratch. Other bases work on inline
+// scratch for values of fewer than ConversionThresholds::TO_STRING limbs, so they neither allocate
+// nor throw there; larger values still convert correctly, one limb-sized chunk of digits per pass.
+class RadixConversion
+{
+public:
+    using limb_type = LimbArithmetic::limb_type;
+
+    // Largest power of base that fits in a limb, and its number of digits.
+    static std::pair<limb_type, size_t> chunk_for_base(limb_type base) noexcept
+    {
+        limb_type power = base;
+        size_t digits = 1;
+        while (power <= std::numeric_limits<limb_type>::max() / base)
+        {
+            power *= base;
+            ++digits;
+        }
+        return {power, digits};
+    }
+
+    // Value of the digit c in either case, or 36 and up if c is not a digit of any base.
+    static constexpr limb_type digit_value(char c) noexcept
+    {
+        return DIGIT_VALUES[static_cast<unsigned char>(c)];
+    }
+
+    // Upper bound on the number of digits of limbs in base, at least 1; 0 for an invalid base.
+    static size_t max_chars(std::span<const limb_type> limbs, int base) noexcept
+    {
+        if (base < 2 || base > 36)
+            return 0;
+
+        const size_t n = LimbArithmetic::normalized_size(limbs.data(), limbs.size());
+        if (n == 0)
+            return 1;
+
+        // Every chunk_digits digits carry at least bit_width(chunk_base) - 1 bits.
+        const auto [chunk_base, chunk_digits] = chunk_for_base(static_cast<limb_type>(base));
+        const size_t chunk_bits = static_cast<size_t>(std::bit_width(chunk_base)) - 1;
+        const size_t bits = n * LimbArithmetic::LIMB_BITS -
+                            static_cast<size_t>(std::countl_zero(limbs[n - 1]));
+        return (bits * chunk_digits + chunk_bits - 1) / chunk_bits;
+    }
+
+    // Writes the digits of limbs to [first, last). On value_too_large the range is left
+    // unspecified and ptr is last.
+    static std::to_chars_result to_chars(char* first, char* last, std::span<const limb_type> limbs,
+                                         int base)
+    {
+        if (base < 2 || base > 36)
+            return {last, std::errc::invalid_argument};
+
+        const auto radix = static_cast<limb_type>(base);
+        const auto [chunk_base, chunk_digits] = chunk_for_base(radix);
+
+        size_t n = LimbArithmetic::normalized_size(limbs.data(), limbs.size());
+        if (std::has_single_bit(radix))
+        {
+            const auto bits = static_cast<unsigned>(std::countr_zero(radix));
+            if (static_cast<size_t>(last - first) <
+                StringConversion::bit_group_count(limbs.data(), n, bits))
+                return {last, std::errc::value_too_large};
+            return {StringConversion::write_bit_groups(first, limbs.data(), n, bits), std::errc{}};
+        }
+
+        if (n == 0)
+        {
+            if (first == last)
+                return {last, std::errc::value_too_large};
+            *first = '0';
+            return {first + 1, std::errc{}};
+        }
+
+        // Least significant chunk first. Each carries more than 32 bits, so there are at most 2n.
+        LimbStorage<ConversionThresholds::TO_STRING> quotient;
+        LimbStorage<2 * ConversionThresholds::TO_STRING> chunks;
+        quotient.resize_for_overwrite(n);
+        chunks.resize_for_overwrite(2 * n);
+        std::copy_n(limbs.data(), n, quotient.data());
+
+        size_t count = 0;
+        while (n > 0)
+        {
+            chunks[count++] = LimbArithmetic::divrem_1(quotient.data(), quotient.data(), n,
+                                                       chunk_base);
+            n = LimbArithmetic::normalized_size(quotient.data(), n);
+        }
+
+        size_t lead = 0;
+        for (limb_type top = chunks[count - 1]; top != 0; top /= radix)
+            ++lead;
+
+        const size_t digits = lead + (count - 1) * chunk_digits;
+        if (static_cast<size_t>(last - first) < digits)
+            return {last, std::errc::value_too_large};
+
+        write_chunk(first, chunks[count - 1], radix, lead);
+        char* out = first + lead;
+        for (size_t i = count - 1; i-- > 0; out += chunk_digits)
+            write_chunk(out, chunks[i], radix, chunk_digits);
+        return {out, std::errc{}};
+    }
+
+    // Parses the longest run of digits valid in base, in either case, into limbs, zero-filling
+    // the limbs above the value. Returns invalid_argument if there is no digit, and
+    // result_out_of_range, with limbs unspecified, if the value needs more limbs than given.
+    static std::from_chars_result from_chars(const char* first, const char* last,
+                                             std::span<limb_type> limbs, int base) noexcept
+    {
+        if (base < 2 || base > 36)
+            return {first, std::errc::invalid_argument};
+
+        const char* end = std::find_if_not(
+            first, last, [base](char c) { return digit_value(c) < static_cast<limb_type>(base); });
+        if (end == first)
+            return {first, std::errc::invalid_argument};
+
+        const auto radix = static_cast<limb_type>(base);
+        if (std::has_single_bit(radix))
+        {
+            // Leading zeros aside, every digit fills its own bits of the result.
+            const char* digits = std::find_if(first, end, [](char c) { return c != '0'; });
+            const auto bits = static_cast<unsigned>(std::countr_zero(radix));
+            size_t bit_length = 0;
+            if (digits != end)
+                bit_length = static_cast<size_t>(end - digits - 1) * bits +
+                             static_cast<size_t>(std::bit_width(digit_value(*digits)));
+
+            const size_t needed = (bit_length + LimbArithmetic::LIMB_BITS - 1) /
+                                  LimbArithmetic::LIMB_BITS;
+            if (needed > limbs.size())
+                return {end, std::errc::result_out_of_range};
+
+            std::fill(limbs.begin(), limbs.end(), limb_type(0));
+            StringConversion::read_bit_groups(digits, end, limbs.data(), needed, bits);
+            return {end, std::errc{}};
+        }
+
+        const auto [chunk_base, chunk_digits] = chunk_for_base(radix);
+        const size_t length = static_cast<size_t>(end - first);
+
+        size_t len = length % chunk_digits;
+        if (len == 0)
+            len = chunk_digits;
+
+        size_t used = 0;
+        for (const char* in = first; in != end; in += len, len = chunk_digits)
+        {
+            limb_type scale = chunk_base;
+            if (len != chunk_digits)
+            {
+                scale = 1;
+                for (size_t i = 0; i < len; ++i)
+                    scale *= radix;
+            }
+
+            limb_type carry = LimbArithmetic::mul_1(limbs.data(), limbs.data(), used, scale);
+            carry += LimbArithmetic::add_1(limbs.data(), limbs.data(), used,
+                                           read_chunk(in, len, radix));
+            if (carry != 0)
+            {
+                if (used == limbs.size())
+                    return {end, std::errc::result_out_of_range};
+                limbs[used++] = carry;
+            }
+        }
+
+        std::fill(limbs.begin() + static_cast<std::ptrdiff_t>(used), limbs.end(), limb_type(0));
+        return {end, std::errc{}};
+    }
+
+private:
+    static constexpr std::array<uint8_t, 256> DIGIT_VALUES = [] {
+        std::array<uint8_t, 256> values{};
+        values.fill(0xFF);
+        for (uint8_t i = 0; i < 36; ++i)
+        {
+            const char c = dtoa::DigitChars<uint8_t, dtoa::CharCase::Upper>::get()[i];
+            values[static_cast<unsigned char>(c)] = i;
+            values[static_cast<unsigned char>(c | 0x20)] = i;
+        }
+        return values;
+    }();
+
+    // count validated digits, most significant first.
+    static limb_type read_chunk(const char* in, size_t count, limb_type radix) noexcept
+    {
+        limb_type chunk = 0;
+        if (radix == 10)
+        {
+            StringConversion::read_decimal(in, count, chunk);
+            return chunk;
+        }
+
+        for (size_t i = 0; i < count; ++i)
+            chunk = chunk * radix + digit_value(in[i]);
+        return chunk;
+    }
+
+    static void write_chunk(char* out, limb_type chunk, limb_type radix, size_t count) noexcept
+    {
+        if (radix == 10)
+        {
+            StringConversion::write_decimal(out, chunk, count);
+            return;
+        }
+
+        constexpr auto chars = dtoa::DigitChars<limb_type, dtoa::CharCase::Upper>::get();
+        for (size_t i = count; i-- > 0; chunk /= radix)
+            out[i] = chars[chunk % radix];
+    }
+};
+
+// Three-prime number theoretic transform multiplication. Every 64-bit limb is one coefficient; the
+// cyclic convolution is computed modulo three ~62-bit primes and recombined with Garner's form of
+// the Chinese remainder theorem, which stays exact for transform lengths up to 2^55.
+class NumberTheoreticTransform
+{
+    using ops = LimbArithmetic;
+
+public:
+    using limb_type = LimbArithmetic::limb_type;
+
+    struct Prime
+    {
+        uint64_t modulus;
+        uint64_t generator;
+    };
+
+    static constexpr size_t PRIME_COUNT = 3;
+    static constexpr int MAX_LOG_LENGTH = 55;
+
+    // c * 2^k + 1 primes with primitive root generator.
+    static constexpr std::array<Prime, PRIME_COUNT> PRIMES = {{
+        {4179340454199820289ULL, 3}, // 29 * 2^57 + 1
+        {2485986994308513793ULL, 5}, // 69 * 2^55 + 1
+        {1945555039024054273ULL, 5}, // 27 * 2^56 + 1
+    }};
+
+    // Montgomery arithmetic modulo a prime below 2^62 with R = 2^64.
+    class Field
+    {
+    public:
+        explicit Field(uint64_t modulus) noexcept : modulus_(modulus)
+        {
+            uint64_t inverse = modulus;
+            for (int i = 0; i < 5; ++i)
+                inverse *= 2 - modulus * inverse;
+            neg_inverse_ = 0 - inverse;
+
+            limb_type r_mod;
+            ops::div_wide(1, 0, modulus, r_mod);
+            limb_type high;
+            const limb_type low = ops::mul_wide(r_mod, r_mod, high);
+            ops::div_wide(high, low, modulus, r_squared_);
+        }
+
+        [[nodiscard]] uint64_t modulus() const noexcept { return modulus_; }
+
+        [[nodiscard]] uint64_t add(uint64_t a, uint64_t b) const noexcept
+        {
+            const uint64_t sum = a + b;
+            return sum >= modulus_ ? sum - modulus_ : sum;
+        }
+
+        [[nodiscard]] uint64_t sub(uint64_t a, uint64_t b) const noexcept
+        {
+            return a >= b ? a - b : a + modulus_ - b;
+        }
+
+        // a * b / R mod p; requires a * b < R * p.
+        [[nodiscard]] uint64_t mul(uint64_t a, uint64_t b) const noexcept
+        {
+            limb_type high;
+            const limb_type low = ops::mul_wide(a, b, high);
+            const limb_type m = low * neg_inverse_;
+            limb_type m_high;
+            ops::mul_wide(m, modulus_, m_high);
+            const uint64_t result = high + m_high + (low != 0);
+            return result >= modulus_ ? result - modulus_ : result;
+        }
+
+        // Accepts any 64-bit value, not only reduced residues.
+        [[nodiscard]] uint64_t to_montgomery(uint64_t x) const noexcept
+        {
+            return mul(x, r_squared_);
+        }
+
+        [[nodiscard]] uint64_t from_montgomery(uint64_t x) const noexcept { return mul(x, 1); }
+
+    private:
+        uint64_t modulus_;
+        uint64_t neg_inverse_;
+        uint64_t r_squared_;
+    };
+
+    static size_t transform_length(size_t an, size_t bn) noexcept
+    {
+        return std::bit_ceil(an + bn - 1);
+    }
+
+    // r[0..an+bn) = a[0..an) * b[0..bn); r must not overlap a or b.
+    static void multiply(limb_type* r, const limb_type* a, size_t an, const limb_type* b,
+                         size_t bn)
+    {
+        const size_t n = transform_length(an, bn);
+        if (std::bit_width(n) - 1 > MAX_LOG_LENGTH)
+            throw std::length_error("Operands too large for the number theoretic transform");
+
+        LimbStorage<0> buffer;
+        buffer.resize_for_overwrite((PRIME_COUNT + 1) * n);
+        uint64_t* temp = buffer.data() + PRIME_COUNT * n;
+
+        for (size_t i = 0; i < PRIME_COUNT; ++i)
+        {
+            const Field field(PRIMES[i].modulus);
+            const auto tables = twiddles(i, n);
+            uint64_t* residues = buffer.data() + i * n;
+
+            load(field, residues, n, a, an);
+            load(field, temp, n, b, bn);
+            forward(field, residues, n, tables->forward.data());
+            forward(field, temp, n, tables->forward.data());
+
+            for (size_t j = 0; j < n; ++j)
+                residues[j] = field.mul(residues[j], temp[j]);
+
+            inverse(field, residues, n, tables->inverse.data());
+        }
+
+        recombine(r, an + bn, buffer.data(), n);
+    }
+
+    // r[0..2n) = a[0..n)^2 with one forward transform per prime instead of two.
+    static void square(limb_type* r, const limb_type* a, size_t an)
+    {
+        const size_t n = transform_length(an, an);
+        if (std::bit_width(n) - 1 > MAX_LOG_LENGTH)
+            throw std::length_error("Operands too large for the number theoretic transform");
+
+        LimbStorage<0> buffer;
+        buffer.resize_for_overwrite(PRIME_COUNT * n);
+
+        for (size_t i = 0; i < PRIME_COUNT; ++i)
+        {
+            const Field field(PRIMES[i].modulus);
+            const auto tables = twiddles(i, n);
+            uint64_t* residues = buffer.data() + i * n;
+
+            load(field, residues, n, a, an);
+            forward(field, residues, n, tables->forward.data());
+
+            for (size_t j = 0; j < n; ++j)
+                residues[j] = field.mul(residues[j], residues[j]);
+
+            inverse(field, residues, n, tables->inverse.data());
+        }
+
+        recombine(r, 2 * an, buffer.data(), n);
+    }
+
+private:
+    // Twiddles for every stage up to length: entry len / 2 + j holds w_len^j in Montgomery form,
+    // so the table for a length is a prefix of the table for any larger one.
+    struct Twiddles
+    {
+        size_t length = 1;
+        std::vector<uint64_t> forward{0};
+        std::vector<uint64_t> inverse{0};
+    };
+
+    static std::shared_ptr<const Twiddles> twiddles(size_t prime_index, size_t length)
+    {
+        static std::mutex mutex;
+        static std::array<std::shared_ptr<const Twiddles>, PRIME_COUNT> cache;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        auto& cached = cache[prime_index];
+        if (cached && cached->length >= length)
+            return cached;
+
+        auto grown = cached ? std::make_shared<Twiddles>(*cached) : std::make_shared<Twiddles>();
+        const auto [modulus, generator] = PRIMES[prime_index];
+        const auto signed_modulus = static_cast<int64_t>(modulus);
+        const Field field(modulus);
+
+        grown->forward.resize(length);
+        grown->inverse.resize(length);
+
+        for (size_t len = grown->length * 2; len <= length; len *= 2)
+        {
+            const uint64_t root = ArithmeticOperations::modular_pow<uint64_t>(
+                generator, (modulus - 1) / len, modulus);
+            const auto root_inverse = static_cast<uint64_t>(
+                ArithmeticOperations::modular_inverse<int64_t>(static_cast<int64_t>(root),
+                                                               signed_modulus));
+
+            const uint64_t step = field.to_montgomery(root);
+            const uint64_t step_inverse = field.to_montgomery(root_inverse);
+            uint64_t w = field.to_montgomery(1);
+            uint64_t w_inverse = w;
+
+            for (size_t j = 0; j < len / 2; ++j)
+            {
+                grown->forward[len / 2 + j] = w;
+                grown->inverse[len / 2 + j] = w_inverse;
+                w = field.mul(w, step);
+                w_inverse = field.mul(w_inverse, step_inverse);
+            }
+        }
+
+        grown->length = length;
+        cached = std::move(grown);
+        return cached;
+    }
+
+    static void load(const Field& field, uint64_t* dst, size_t n, const limb_type* src,
+                     size_t sn) noexcept
+    {
+        for (size_t i = 0; i < sn; ++i)
+            dst[i] = field.to_montgomery(src[i]);
+        std::fill(dst + sn, dst + n, uint64_t(0));
+    }
+
+    // Decimation in frequency: natural order in, bit-reversed order out.
+    static void forward(const Field& field, uint64_t* a, size_t n, const uint64_t* roots) noexcept
+    {
+        for (size_t len = n; len >= 2; len /= 2)
+        {
+            const size_t half = len / 2;
+            const uint64_t* w = roots + half;
+            for (size_t i = 0; i < n; i += len)
+            {
+                for (size_t j = 0; j < half; ++j)
+                {
+                    const uint64_t u = a[i + j];
+                    const uint64_t v = a[i + j + half];
+                    a[i + j] = field.add(u, v);
+                    a[i + j + half] = field.mul(field.sub(u, v), w[j]);
+                }
+            }
+        }
+    }
+
+    // Decimation in time: bit-reversed order in, natural order out, scaled by 1/n and converted
+    // out of Montgomery form.
+    static void inverse(const Field& field, uint64_t* a, size_t n, const uint64_t* roots)
+    {
+        for (size_t len = 2; len <= n; len *= 2)
+        {
+            const size_t half = len / 2;
+            const uint64_t* w = roots + half;
+            for (size_t i = 0; i < n; i += len)
+            {
+                for (size_t j = 0; j < half; ++j)
+                {
+                    const uint64_t u = a[i + j];
+                    const uint64_t v = field.mul(a[i + j + half], w[j]);
+                    a[i + j] = field.add(u, v);
+                    a[i + j + half] = field.sub(u, v);
+                }
+            }
+        }
+
+        const auto modulus = static_cast<int64_t>(field.modulus());
+        const auto scale = static_cast<uint64_t>(ArithmeticOperations::modular_inverse<int64_t>(
+            static_cast<int64_t>(n % field.modulus()), modulus));
+        for (size_t i = 0; i < n; ++i)
+            a[i] = field.mul(a[i], scale);
+    }
+
+    // Garner recombination of the three residue vectors into r[0..rn), propagating carries.
+    static void recombine(limb_type* r, size_t rn, const uint64_t* residues, size_t n)
+    {
+        const uint64_t p1 = PRIMES[0].modulus;
+        const uint64_t p2 = PRIMES[1].modulus;
+        const uint64_t p3 = PRIMES[2].modulus;
+        const Field f2(p2);
+        const Field f3(p3);
+
+        const auto inverse_of = [](uint64_t value, uint64_t modulus) {
+            return static_cast<uint64_t>(ArithmeticOperations::modular_inverse<int64_t>(
+                static_cast<int64_t>(value % modulus), static_cast<int64_t>(modulus)));
+        };
+
+        limb_type p12_high;
+        const limb_type p12_low = ops::mul_wide(p1, p2, p12_high);
+        limb_type p12_mod_p3;
+        ops::div_wide(p12_high % p3, p12_low, p3, p12_mod_p3);
+
+        // Montgomery-scaled constants, so that f.mul(x, c) yields x * c in plain form.
+        const uint64_t p1_inverse = f2.to_montgomery(inverse_of(p1, p2));
+        const uint64_t p12_inverse = f3.to_montgomery(inverse_of(p12_mod_p3, p3));
+        const uint64_t p1_mod_p3 = f3.to_montgomery(p1 % p3);
+
+        const uint64_t* res1 = residues;
+        const uint64_t* res2 = residues + n;
+        const uint64_t* res3 = residues + 2 * n;
+        const size_t coefficients = rn - 1;
+
+        limb_type carry[3] = {0, 0, 0};
+        for (size_t i = 0; i < rn; ++i)
+        {
+            limb_type x[3] = {0, 0, 0};
+            if (i < coefficients)
+            {
+                const uint64_t r1 = res1[i];
+                const uint64_t t2 = f2.mul(f2.sub(res2[i], r1 >= p2 ? r1 - p2 : r1), p1_inverse);
+
+                uint64_t r1_mod_p3 = r1;
+                while (r1_mod_p3 >= p3)
+                    r1_mod_p3 -= p3;
+                const uint64_t x12 = f3.add(r1_mod_p3, f3.mul(t2, p1_mod_p3));
+                const uint64_t t3 = f3.mul(f3.sub(res3[i], x12), p12_inverse);
+
+                // x = r1 + p1 * t2 + p1 * p2 * t3
+                limb_type low_high, high_high;
+                x[0] = ops::mul_wide(p12_low, t3, low_high);
+                x[1] = ops::mul_wide(p12_high, t3, high_high) + low_high;
+                x[2] = high_high + (x[1] < low_high);
+
+                limb_type t2_high;
+                const limb_type t2_low = ops::mul_wide(p1, t2, t2_high);
+                const limb_type addend[2] = {t2_low, t2_high};
+                ops::add(x, x, 3, addend, 2);
+                ops::add_1(x, x, 3, r1);
+            }
+
+            ops::add_n(x, x, carry, 3);
+            r[i] = x[0];
+            carry[0] = x[1];
+            carry[1] = x[2];
+        }
+    }
+};
+
+// Karatsuba and Toom-Cook multiplication over limb spans. Every recursive level carves its
+// temporaries out of a single scratch buffer sized by scratch_size(), so a multiplication performs
+// at most one allocation regardless of depth.
+class Multiplication
+{
+    using ops = LimbArithmetic;
+    using thresholds = MultiplicationThresholds;
+
+public:
+    using limb_type = LimbArithmetic::limb_type;
+
+    // Upper bound on the scratch limbs used by mul() when the larger operand has n limbs.
+    static constexpr size_t scratch_size(size_t n) noexcept
+    {
+        return 8 * n + 64 * static_cast<size_t>(std::bit_width(n)) + 64;
+    }
+
+    // r[0..an+bn) = a[0..an) * b[0..bn) for any an, bn >= 1; r must not overlap a or b.
+    static void multiply(limb_type* r, const limb_type* a, size_t an, const limb_type* b,
+                         size_t bn)
+    {
+        if (a == b && an == bn)
+        {
+            square(r, a, an);
+            return;
+        }
+
+        if (an < bn)
+        {
+            std::swap(a, b);
+            std::swap(an, bn);
+        }
+
+        if (bn < thresholds::KARATSUBA)
+        {
+            ops::mul_basecase(r, a, an, b, bn);
+            return;
+        }
+
+        if (bn >= thresholds::NTT)
+        {
+            NumberTheoreticTransform::multiply(r, a, an, b, bn);
+            return;
+        }
+
+        LimbStorage<0> scratch;
+        scratch.resize_for_overwrite(scratch_size(an));
+        mul(r, a, an, b, bn, scratch.data());
+    }
+
+    // r[0..2n) = a[0..n)^2 for n >= 1; r must not overlap a.
+    static void square(limb_type* r, const limb_type* a, size_t n)
+    {
+        if (n < thresholds::SQR_KARATSUBA)
+        {
+            ops::sqr_basecase(r, a, n);
+            return;
+        }
+
+        if (n >= thresholds::NTT)
+        {
+            NumberTheoreticTransform::square(r, a, n);
+            return;
+        }
+
+        LimbStorage<0> scratch;
+        scratch.resize_for_overwrite(scratch_size(n));
+        sqr(r, a, n, scratch.data());
+    }
+
+    // Recursive dispatcher; requires an >= bn >= 1 and scratch_size(an) limbs of scratch.
+    static void mul(limb_type* r, const limb_type* a, size_t an, const limb_type* b, size_t bn,
+                    limb_type* scratch)
+    {
+        if (bn < thresholds::KARATSUBA)
+            ops::mul_basecase(r, a, an, b, bn);
+        else if (bn >= thresholds::TOOM4 && bn > 3 * toom_split(an, 4))
+            toom4(r, a, an, b, bn, scratch);
+        else if (bn >= thresholds::TOOM3 && bn > 2 * toom_split(an, 3))
+            toom3(r, a, an, b, bn, scratch);
+        else if (bn > toom_split(an, 2))
+            karatsuba(r, a, an, b, bn, scratch);
+        else
+            mul_unbalanced(r, a, an, b, bn, scratch);
+    }
+
+    // Splits a into bn-limb blocks so that every partial product is balanced.
+    static void mul_unbalanced(limb_type* r, const limb_type* a, size_t an, const limb_type* b,
+                               size_t bn, limb_type* scratch)
+    {
+        limb_type* partial = scratch;
+        limb_type* next = scratch + 2 * bn;
+
+        mul(r, a, bn, b, bn, next);
+
+        for (size_t done = bn; done < an;)
+        {
+            const size_t len = std::min(bn, an - done);
+            if (len == bn)
+                mul(partial, a + done, bn, b, bn, next);
+            else
+                mul(partial, b, bn, a + done, len, next);
+
+            const limb_type carry = ops::add_n(r + done, r + done, partial, bn);
+            std::copy(partial + bn, partial + bn + len, r + done + bn);
+            ops::add_1(r + done + bn, r + done + bn, len, carry);
+            done += len;
+        }
+    }
+
+    // Subtractive Karatsuba; requires an >= bn > ceil(an / 2).
+    static void karatsuba(limb_type* r, const limb_type* a, size_t an, const limb_type* b,
+                          size_t bn, limb_type* scratch)
+    {
+        const size_t h = toom_split(an, 2);
+        const size_t a1n = an - h;
+        const size_t b1n = bn - h;
+        const size_t rn = an + bn;
+
+        limb_type* middle = scratch;
+        limb_type* a_diff = scratch + 2 * h;
+        limb_type* b_diff = a_diff + h;
+        limb_type* next = scratch + 4 * h + 1;
+
+        mul(r, a, h, b, h, next);
+        mul(r + 2 * h, a + h, a1n, b + h, b1n, next);
+
+        const bool negative =
+            abs_diff(a_diff, a, h, a + h, a1n) != abs_diff(b_diff, b, h, b + h, b1n);
+        mul(middle, a_diff, h, b_diff, h, next);
+
+        // a0*b1 + a1*b0 = z0 + z2 - (a0 - a1)(b0 - b1)
+        limb_type* sum = a_diff;
+        sum[2 * h] = ops::add(sum, r, 2 * h, r + 2 * h, rn - 2 * h);
+        if (negative)
+            sum[2 * h] += ops::add_n(sum, sum, middle, 2 * h);
+        else
+            sum[2 * h] -= ops::sub_n(sum, sum, middle, 2 * h);
+
+        add_at(r, rn, h, sum, 2 * h + 1);
+    }
+
+    // Toom-3 evaluated at 0, 1, -1, -2 and infinity; requires an >= bn > 2 * ceil(an / 3).
+    static void toom3(limb_type* r, const limb_type* a, size_t an, const limb_type* b, size_t bn,
+                      limb_type* scratch)
+    {
+        const size_t k = toom_split(an, 3);
+        const size_t width = 2 * k + 2;
+        const size_t e = k + 1;
+        const size_t rn = an + bn;
+        const size_t a2n = an - 2 * k;
+        const size_t b2n = bn - 2 * k;
+        const size_t r4n = a2n + b2n;
+
+        limb_type* v1 = scratch;
+        limb_type* vm1 = v1 + width;
+        limb_type* vm2 = vm1 + width;
+        limb_type* a_even = vm2 + width;
+        limb_type* a_odd = a_even + e;
+        limb_type* a_sum = a_odd + e;
+        limb_type* b_even = a_sum + e;
+        limb_type* b_odd = b_even + e;
+        limb_type* b_sum = b_odd + e;
+        limb_type* next = b_sum + e;
+
+        mul(r, a, k, b, k, next);
+        mul(r + 4 * k, a + 2 * k, a2n, b + 2 * k, b2n, next);
+
+        // Points 1 and -1: even part a0 + a2, odd part a1.
+        evaluate(a_even, e, {{a, k, 1}, {a + 2 * k, a2n, 1}});
+        evaluate(a_odd, e, {{a + k, k, 1}});
+        evaluate(b_even, e, {{b, k, 1}, {b + 2 * k, b2n, 1}});
+        evaluate(b_odd, e, {{b + k, k, 1}});
+        bool negative =
+            split_point(a_sum, a_even, a_odd, e) != split_point(b_sum, b_even, b_odd, e);
+        mul(v1, a_sum, e, b_sum, e, next);
+        mul(vm1, a_even, e, b_even, e, next);
+        if (negative)
+            negate(vm1, width);
+
+        // Point -2: even part a0 + 4*a2, odd part 2*a1.
+        evaluate(a_even, e, {{a, k, 1}, {a + 2 * k, a2n, 4}});
+        evaluate(a_odd, e, {{a + k, k, 2}});
+        evaluate(b_even, e, {{b, k, 1}, {b + 2 * k, b2n, 4}});
+        evaluate(b_odd, e, {{b + k, k, 2}});
+        negative =
+            abs_diff(a_even, a_even, e, a_odd, e) != abs_diff(b_even, b_even, e, b_odd, e);
+        mul(vm2, a_even, e, b_even, e, next);
+        if (negative)
+            negate(vm2, width);
+
+        toom3_interpolate(r, rn, k, r4n, v1, vm1, vm2);
+    }
+
+    // Toom-4 evaluated at 0, 1, -1, 2, -2, 1/2 and infinity; requires an >= bn > 3 * ceil(an / 4).
+    static void toom4(limb_type* r, const limb_type* a, size_t an, const limb_type* b, size_t bn,
+                      limb_type* scratch)
+    {
+        const size_t k = toom_split(an, 4);
+        const size_t width = 2 * k + 2;
+        const size_t e = k + 1;
+        const size_t rn = an + bn;
+        const size_t a3n = an - 3 * k;
+        const size_t b3n = bn - 3 * k;
+        const size_t r6n = a3n + b3n;
+
+        limb_type* w1 = scratch;
+        limb_type* wm1 = w1 + width;
+        limb_type* w2 = wm1 + width;
+        limb_type* wm2 = w2 + width;
+        limb_type* wh = wm2 + width;
+        limb_type* a_even = wh + width;
+        limb_type* a_odd = a_even + e;
+        limb_type* a_sum = a_odd + e;
+        limb_type* b_even = a_sum + e;
+        limb_type* b_odd = b_even + e;
+        limb_type* b_sum = b_odd + e;
+        limb_type* next = b_sum + e;
+
+        mul(r, a, k, b, k, next);
+        mul(r + 6 * k, a + 3 * k, a3n, b + 3 * k, b3n, next);
+
+        // Points 1 and -1: even part a0 + a2, odd part a1 + a3.
+        evaluate(a_even, e, {{a, k, 1}, {a + 2 * k, k, 1}});
+        evaluate(a_odd, e, {{a + k, k, 1}, {a + 3 * k, a3n, 1}});
+        evaluate(b_even, e, {{b, k, 1}, {b + 2 * k, k, 1}});
+        evaluate(b_odd, e, {{b + k, k, 1}, {b + 3 * k, b3n, 1}});
+        bool negative =
+            split_point(a_sum, a_even, a_odd, e) != split_point(b_sum, b_even, b_odd, e);
+        mul(w1, a_sum, e, b_sum, e, next);
+        mul(wm1, a_even, e, b_even, e, next);
+        if (negative)
+            negate(wm1, width);
+
+        // Points 2 and -2: even part a0 + 4*a2, odd part 2*a1 + 8*a3.
+        evaluate(a_even, e, {{a, k, 1}, {a + 2 * k, k, 4}});
+        evaluate(a_odd, e, {{a + k, k, 2}, {a + 3 * k, a3n, 8}});
+        evaluate(b_even, e, {{b, k, 1}, {b + 2 * k, k, 4}});
+        evaluate(b_odd, e, {{b + k, k, 2}, {b + 3 * k, b3n, 8}});
+        negative =
+            split_point(a_sum, a_even, a_odd, e) != split_point(b_sum, b_even, b_odd, e);
+        mul(w2, a_sum, e, b_sum, e, next);
+        mul(wm2, a_even, e, b_even, e, next);
+        if (negative)
+            negate(wm2, width);
+
+        // Point 1/2, scaled by 8: 8*a0 + 4*a1 + 2*a2 + a3.
+        evaluate(a_sum, e, {{a, k, 8}, {a + k, k, 4}, {a + 2 * k, k, 2}, {a + 3 * k, a3n, 1}});
+        evaluate(b_sum, e, {{b, k, 8}, {b + k, k, 4}, {b + 2 * k, k, 2}, {b + 3 * k, b3n, 1}});
+        mul(wh, a_sum, e, b_sum, e, next);
+
+        toom4_interpolate(r, rn, k, r6n, w1, wm1, w2, wm2, wh);
+    }
+
+    // Recursive squaring dispatcher; requires n >= 1 and scratch_size(n) limbs of scratch.
+    static void sqr(limb_type* r, const limb_type* a, size_t n, limb_type* scratch)
+    {
+        if (n < thresholds::SQR_KARATSUBA)
+            ops::sqr_basecase(r, a, n);
+        else if (n >= thresholds::TOOM4 && n > 3 * toom_split(n, 4))
+            toom4_sqr(r, a, n, scratch);
+        else if (n >= thresholds::TOOM3 && n > 2 * toom_split(n, 3))
+            toom3_sqr(r, a, n, scratch);
+        else
+            karatsuba_sqr(r, a, n, scratch);
+    }
+
+    // Karatsuba squaring: a0*a1 doubled is a0^2 + a1^2 - (a0 - a1)^2, so the middle term never
+    // changes sign. Requires n >= 2.
+    static void karatsuba_sqr(limb_type* r, const limb_type* a, size_t n, limb_type* scratch)
+    {
+        const size_t h = toom_split(n, 2);
+        const size_t rn = 2 * n;
+
+        limb_type* middle = scratch;
+        limb_type* diff = scratch + 2 * h;
+        limb_type* next = scratch + 4 * h + 1;
+
+        sqr(r, a, h, next);
+        sqr(r + 2 * h, a + h, n - h, next);
+
+        abs_diff(diff, a, h, a + h, n - h);
+        sqr(middle, diff, h, next);
+
+        limb_type* sum = diff;
+        sum[2 * h] = ops::add(sum, r, 2 * h, r + 2 * h, rn - 2 * h);
+        sum[2 * h] -= ops::sub_n(sum, sum, middle, 2 * h);
+
+        add_at(r, rn, h, sum, 2 * h + 1);
+    }
+
+    // Toom-3 squaring: five squares of the evaluated points, which are all non-negative.
+    // Requires n > 2 * ceil(n / 3).
+    static void toom3_sqr(limb_type* r, const limb_type* a, size_t n, limb_type* scratch)
+    {
+        const size_t k = toom_split(n, 3);
+        const size_t width = 2 * k + 2;
+        const size_t e = k + 1;
+        const size_t a2n = n - 2 * k;
+
+        limb_type* v1 = scratch;
+        limb_type* vm1 = v1 + width;
+        limb_type* vm2 = vm1 + width;
+        limb_type* even = vm2 + width;
+        limb_type* odd = even + e;
+        limb_type* sum = odd + e;
+        limb_type* next = sum + e;
+
+        sqr(r, a, k, next);
+        sqr(r + 4 * k, a + 2 * k, a2n, next);
+
+        evaluate(even, e, {{a, k, 1}, {a + 2 * k, a2n, 1}});
+        evaluate(odd, e, {{a + k, k, 1}});
+        split_point(sum, even, odd, e);
+        sqr(v1, sum, e, next);
+        sqr(vm1, even, e, next);
+
+        evaluate(even, e, {{a, k, 1}, {a + 2 * k, a2n, 4}});
+        evaluate(odd, e, {{a + k, k, 2}});
+        abs_diff(even, even, e, odd, e);
+        sqr(vm2, even, e, next);
+
+        toom3_interpolate(r, 2 * n, k, 2 * a2n, v1, vm1, vm2);
+    }
+
+    // Toom-4 squaring: seven squares of the evaluated points. Requires n > 3 * ceil(n / 4).
+    static void toom4_sqr(limb_type* r, const limb_type* a, size_t n, limb_type* scratch)
+    {
+        const size_t k = toom_split(n, 4);
+        const size_t width = 2 * k + 2;
+        const size_t e = k + 1;
+        const size_t a3n = n - 3 * k;
+
+        limb_type* w1 = scratch;
+        limb_type* wm1 = w1 + width;
+        limb_type* w2 = wm1 + width;
+        limb_type* wm2 = w2 + width;
+        limb_type* wh = wm2 + width;
+        limb_type* even = wh + width;
+        limb_type* odd = even + e;
+        limb_type* sum = odd + e;
+        limb_type* next = sum + e;
+
+        sqr(r, a, k, next);
+        sqr(r + 6 * k, a + 3 * k, a3n, next);
+
+        evaluate(even, e, {{a, k, 1}, {a + 2 * k, k, 1}});
+        evaluate(odd, e, {{a + k, k, 1}, {a + 3 * k, a3n, 1}});
+        split_point(sum, even, odd, e);
+        sqr(w1, sum, e, next);
+        sqr(wm1, even, e, next);
+
+        evaluate(even, e, {{a, k, 1}, {a + 2 * k, k, 4}});
+        evaluate(odd, e, {{a + k, k, 2}, {a + 3 * k, a3n, 8}});
+        split_point(sum, even, odd, e);
+        sqr(w2, sum, e, next);
+        sqr(wm2, even, e, next);
+
+        evaluate(sum, e, {{a, k, 8}, {a + k, k, 4}, {a + 2 * k, k, 2}, {a + 3 * k, a3n, 1}});
+        sqr(wh, sum, e, next);
+
+        toom4_interpolate(r, 2 * n, k, 2 * a3n, w1, wm1, w2, wm2, wh);
+    }
+
+private:
+    struct Term
+    {
+        const limb_type* limbs;
+        size_t size;
+        limb_type factor;
+    };
+
+    static constexpr size_t toom_split(size_t n, size_t parts) noexcept
+    {
+        return (n + parts - 1) / parts;
+    }
+
+    // r[0..rn) = sum of factor * limbs over the terms; the sum must fit in rn limbs.
+    static void evaluate(limb_type* r, size_t rn, std::initializer_list<Term> terms) noexcept
+    {
+        std::fill(r, r + rn, limb_type(0));
+        for (const auto& term : terms)
+        {
+            const limb_type carry = ops::addmul_1(r, term.limbs, term.size, term.factor);
+            ops::add_1(r + term.size, r + term.size, rn - term.size, carry);
+        }
+    }
+
+    // sum = even + odd and even = |even - odd|; returns true when even - odd is negative.
+    static bool split_point(limb_type* sum, limb_type* even, const limb_type* odd,
+                            size_t n) noexcept
+    {
+        ops::add_n(sum, even, odd, n);
+        if (ops::compare(even, odd, n) >= 0)
+        {
+            ops::sub_n(even, even, odd, n);
+            return false;
+        }
+        ops::sub_n(even, odd, even, n);
+        return true;
+    }
+
+    // r[0..an) = |a - b| for an >= bn; returns true when a < b.
+    static bool abs_diff(limb_type* r, const limb_type* a, size_t an, const limb_type* b,
+                         size_t bn) noexcept
+    {
+        if (ops::normalized_size(a + bn, an - bn) != 0 || ops::compare(a, b, bn) >= 0)
+        {
+            ops::sub(r, a, an, b, bn);
+            return false;
+        }
+        ops::sub_n(r, b, a, bn);
+        std::fill(r + bn, r + an, limb_type(0));
+        return true;
+    }
+
+    // Recovers c1, c2 and c3 from the values at 1, -1 and -2 (each width = 2k + 2 limbs, clobbered)
+    // given c0 = r[0..2k) and c4 = r[4k..4k+r4n), and adds them into r[0..rn).
+    static void toom3_interpolate(limb_type* r, size_t rn, size_t k, size_t r4n, limb_type* v1,
+                                  limb_type* vm1, limb_type* vm2) noexcept
+    {
+        const size_t width = 2 * k + 2;
+        const limb_type* r0 = r;
+        const limb_type* r4 = r + 4 * k;
+
+        // Bodrato's interpolation sequence in width-limb two's complement.
+        ops::sub_n(vm2, vm2, v1, width);
+        divexact_1(vm2, vm2, width, 3);
+        ops::sub_n(v1, v1, vm1, width);
+        arithmetic_rshift(v1, width, 1);
+        ops::sub(vm1, vm1, width, r0, 2 * k);
+        ops::sub_n(vm2, vm1, vm2, width);
+        arithmetic_rshift(vm2, width, 1);
+        ops::add(vm2, vm2, width, r4, r4n);
+        ops::add(vm2, vm2, width, r4, r4n);
+        ops::add_n(vm1, vm1, v1, width);
+        ops::sub(vm1, vm1, width, r4, r4n);
+        ops::sub_n(v1, v1, vm2, width);
+
+        std::fill(r + 2 * k, r + 4 * k, limb_type(0));
+        add_at(r, rn, k, v1, width);
+        add_at(r, rn, 2 * k, vm1, width);
+        add_at(r, rn, 3 * k, vm2, width);
+    }
+
+    // Recovers c1..c5 from the values at 1, -1, 2, -2 and 1/2 (each width = 2k + 2 limbs,
+    // clobbered) given c0 = r[0..2k) and c6 = r[6k..6k+r6n), and adds them into r[0..rn).
+    static void toom4_interpolate(limb_type* r, size_t rn, size_t k, size_t r6n, limb_type* w1,
+                                  limb_type* wm1, limb_type* w2, limb_type* wm2,
+                                  limb_type* wh) noexcept
+    {
+        const size_t width = 2 * k + 2;
+        const limb_type* r0 = r;
+        const limb_type* r6 = r + 6 * k;
+
+        // Odd coefficient sums O1 = c1 + c3 + c5 and O2 = c1 + 4*c3 + 16*c5, even sums
+        // E1 = c0 + c2 + c4 + c6 and E2 = c0 + 4*c2 + 16*c4 + 64*c6.
+        ops::sub_n(w1, w1, wm1, width);
+        arithmetic_rshift(w1, width, 1);
+        ops::add_n(wm1, wm1, w1, width);
+        ops::sub_n(w2, w2, wm2, width);
+        arithmetic_rshift(w2, width, 2);
+        ops::add_n(wm2, wm2, w2, width);
+        ops::add_n(wm2, wm2, w2, width);
+
+        // c2 + c4 and c2 + 4*c4, then c4 and c2.
+        ops::sub(wm1, wm1, width, r0, 2 * k);
+        ops::sub(wm1, wm1, width, r6, r6n);
+        ops::sub(wm2, wm2, width, r0, 2 * k);
+        submul_at(wm2, width, r6, r6n, 64);
+        arithmetic_rshift(wm2, width, 2);
+        ops::sub_n(wm2, wm2, wm1, width);
+        divexact_1(wm2, wm2, width, 3);
+        ops::sub_n(wm1, wm1, wm2, width);
+
+        // 16*c1 + 4*c3 + c5 from the 1/2 point, then c1 - c5.
+        submul_at(wh, width, r0, 2 * k, 64);
+        submul_at(wh, width, wm1, width, 16);
+        submul_at(wh, width, wm2, width, 4);
+        ops::sub(wh, wh, width, r6, r6n);
+        arithmetic_rshift(wh, width, 1);
+        ops::sub_n(wh, wh, w2, width);
+        divexact_1(wh, wh, width, 15);
+
+        // c5, c3 and c1.
+        ops::sub_n(w2, w2, w1, width);
+        divexact_1(w2, w2, width, 3);
+        ops::sub_n(w1, w1, wh, width);
+        ops::sub_n(w2, w2, w1, width);
+        divexact_1(w2, w2, width, 3);
+        ops::sub_n(w1, w1, w2, width);
+        ops::sub_n(w1, w1, w2, width);
+        ops::add_n(wh, wh, w2, width);
+
+        std::fill(r + 2 * k, r + 6 * k, limb_type(0));
+        add_at(r, rn, k, wh, width);
+        add_at(r, rn, 2 * k, wm1, width);
+        add_at(r, rn, 3 * k, w1, width);
+        add_at(r, rn, 4 * k, wm2, width);
+        add_at(r, rn, 5 * k, w2, width);
+    }
+
+    // r[offset..rn) += c, where c is known to fit in the remaining limbs.
+    static void add_at(limb_type* r, size_t rn, size_t offset, const limb_type* c,
+                       size_t cn) noexcept
+    {
+        cn = std::min(ops::normalized_size(c, cn), rn - offset);
+        ops::add(r + offset, r + offset, rn - offset, c, cn);
+    }
+
+    // r[0..rn) -= factor * c modulo B^rn.
+    static void submul_at(limb_type* r, size_t rn, const limb_type* c, size_t cn,
+                          limb_type factor) noexcept
+    {
+        const limb_type borrow = ops::submul_1(r, c, cn, factor);
+        ops::sub_1(r + cn, r + cn, rn - cn, borrow);
+    }
+
+    static void negate(limb_type* r, size_t n) noexcept
+    {
+        for (size_t i = 0; i < n; ++i)
+            r[i] = ~r[i];
+        ops::add_1(r, r, n, 1);
+    }
+
+    static void arithmetic_rshift(limb_type* r, size_t n, unsigned count) noexcept
+    {
+        const bool negative = r[n - 1] >> (LimbArithmetic::LIMB_BITS - 1);
+        ops::rshift(r, r, n, count);
+        if (negative)
+            r[n - 1] |= ~limb_type(0) << (LimbArithmetic::LIMB_BITS - count);
+    }
+
+    // Exact division by an odd single limb via its inverse modulo 2^64 (Hensel division), so it
+    // also divides two's complement values exactly.
+    static void divexact_1(limb_type* r, const limb_type* a, size_t n, limb_type d) noexcept
+    {
+        limb_type inverse = d;
+        for (int i = 0; i < 5; ++i)
+            inverse *= 2 - d * inverse;
+
+        limb_type borrow = 0;
+        for (size_t i = 0; i < n; ++i)
+        {
+            const limb_type s = a[i];
+            const limb_type q = (s - borrow) * inverse;
+            const limb_type next_borrow = s < borrow;
+            r[i] = q;
+
+            limb_type high;
+            ops::mul_wide(q, d, high);
+            borrow = high + next_borrow;
+        }
+    }
+};
+
+// Burnikel-Ziegler recursive division. The quotient is produced in divisor-sized blocks; each
+// block divides by the top half of the divisor recursively and corrects with one multiplication by
+// the bottom half, so division runs in O(M(n) log n) on top of the fast multipliers.
+class Division
+{
+    using ops = LimbArithmetic;
+    using thresholds = DivisionThresholds;
+
+public:
+    using limb_type = LimbArithmetic::limb_type;
+
+    // q[0..an-bn+1) = a / b, r[0..bn) = a mod b, with the same contract as LimbArithmetic::divrem.
+    static void divrem(limb_type* q, limb_type* r, const limb_type* a, size_t an,
+                       const limb_type* b, size_t bn)
+    {
+        if (bn < thresholds::BURNIKEL_ZIEGLER || an - bn < thresholds::BURNIKEL_ZIEGLER)
+        {
+            ops::divrem(q, r, a, an, b, bn);
+            return;
+        }
+
+        const unsigned shift =
+            static_cast<unsigned>(BitManipulation::count_leading_zeros(b[bn - 1]));
+        const size_t un = an + 1;
+
+        LimbStorage<0> scratch;
+        scratch.resize_for_overwrite(un + 2 * bn);
+        limb_type* u = scratch.data();
+        limb_type* v = u + un;
+        limb_type* temp = v + bn;
+
+        if (shift != 0)
+        {
+            ops::lshift(v, b, bn, shift);
+            u[an] = ops::lshift(u, a, an, shift);
+        }
+        else
+        {
+            std::copy(b, b + bn, v);
+            std::copy(a, a + an, u);
+            u[an] = 0;
+        }
+
+        // The top bn limbs of u are below v, so no block produces a carry out of the quotient.
+        const size_t qn = un - bn;
+        size_t done = qn - ((qn - 1) % bn + 1);
+        divrem_block(q + done, u + done, qn - done, v, bn, temp);
+
+        while (done > 0)
+        {
+            done -= bn;
+            divrem_n(q + done, u + done, v, bn, temp);
+        }
+
+        if (shift != 0)
+            ops::rshift(r, u, bn, shift);
+        else
+            std::copy(u, u + bn, r);
+    }
+
+    // Divides a[0..2n) by the normalized d[0..n) in place: q[0..n) receives the low quotient
+    // limbs, a[0..n) the remainder, and the quotient's top limb (0 or 1) is returned. temp must
+    // hold n limbs.
+    static limb_type divrem_n(limb_type* q, limb_type* a, const limb_type* d, size_t n,
+                              limb_type* temp)
+    {
+        if (n < thresholds::BURNIKEL_ZIEGLER)
+            return ops::divrem_normalized(q, a, 2 * n, d, n);
+
+        const size_t lo = n / 2;
+        const size_t hi = n - lo;
+
+        // High quotient half from the top 2*hi limbs and the top hi limbs of d.
+        limb_type qh = divrem_n(q + lo, a + 2 * lo, d + lo, hi, temp);
+        Multiplication::multiply(temp, q + lo, hi, d, lo);
+        limb_type borrow = ops::sub_n(a + lo, a + lo, temp, n);
+        if (qh != 0)
+            borrow += ops::sub_n(a + n, a + n, d, lo);
+
+        while (borrow != 0)
+        {
+            qh -= ops::sub_1(q + lo, q + lo, hi, 1);
+            borrow -= ops::add_n(a + lo, a + lo, d, n);
+        }
+
+        // Low quotient half from a[hi..n+lo) and the top lo limbs of d.
+        const limb_type ql = divrem_n(q, a + hi, d + hi, lo, temp);
+        Multiplication::multiply(temp, q, lo, d, hi);
+        borrow = ops::sub_n(a, a, temp, n);
+        if (ql != 0)
+            borrow += ops::sub_n(a + lo, a + lo, d, hi);
+
+        while (borrow != 0)
+        {
+            ops::sub_1(q, q, lo, 1);
+            borrow -= ops::add_n(a, a, d, n);
+        }
+
+        return qh;
+    }
+
+private:
+    // Divides a[0..m+n) by the normalized d[0..n) for 1 <= m <= n, with the top n limbs of a below
+    // d: q[0..m) receives the quotient and a[0..n) the remainder.
+    static void divrem_block(limb_type* q, limb_type* a, size_t m, const limb_type* d, size_t n,
+                             limb_type* temp)
+    {
+        if (m == n)
+        {
+            divrem_n(q, a, d, n, temp);
+            return;
+        }
+
+        if (m < thresholds::BURNIKEL_ZIEGLER)
+        {
+            ops::divrem_normalized(q, a, m + n, d, n);
+            return;
+        }
+
+        // Estimate from the top m limbs of d, then correct with the bottom n - m limbs.
+        limb_type qh = divrem_n(q, a + n - m, d + n - m, m, temp);
+        Multiplication::multiply(temp, d, n - m, q, m);
+        limb_type borrow = ops::sub_n(a, a, temp, n);
+        if (qh != 0)
+            borrow += ops::sub_n(a + m, a + m, d, n - m);
+
+        while (borrow != 0)
+        {
+            qh -= ops::sub_1(q, q, m, 1);
+            borrow -= ops::add_n(a, a, d, n);
+        }
+    }
+};
+
+// Barrett reduction modulo a fixed native unsigned modulus m. The modulus is shifted so its top
+// bit is set, m' = m * 2^s, and floor(4^64 / m') - 2^64 is stored once; every later reduction of a
+// double-width value costs two multiplications and at most two corrections, with no division.
+template <UnsignedIntegral T>
+    requires(sizeof(T) <= sizeof(uint64_t) && !std::same_as<T, bool>)
+class BarrettReducer<T>
+{
+    using ops = LimbArithmetic;
+    using limb_type = LimbArithmetic::limb_type;
+
+public:
+    explicit BarrettReducer(T modulus)
+    {
+        if (modulus == 0)
+            throw std::domain_error("Modulus must be positive");
+
+        modulus_ = modulus;
+        shift_ = static_cast<unsigned>(std::countl_zero(static_cast<limb_type>(modulus)));
+        divisor_ = static_cast<limb_type>(modulus) << shift_;
+
+        limb_type remainder;
+        reciprocal_ = ops::div_wide(~divisor_, ~limb_type(0), divisor_, remainder);
+    }
+
+    [[nodiscard]] T modulus() const noexcept { return modulus_; }
+
+    [[nodiscard]] T reduce(T x) const noexcept { return x < modulus_ ? x : reduce(0, x); }
+
+    // (high * 2^64 + low) mod m; requires high < m.
+    [[nodiscard]] T reduce(limb_type high, limb_type low) const noexcept
+    {
+        const limb_type u1 = shift_ == 0 ? high : (high << shift_) | (low >> (64 - shift_));
+        const limb_type u0 = low << shift_;
+
+        // floor(u1 * (2^64 + reciprocal) / 2^64) undershoots u / m' by at most two.
+        limb_type q;
+        ops::mul_wide(u1, reciprocal_, q);
+        q += u1;
+
+        limb_type product_high;
+        const limb_type product_low = ops::mul_wide(q, divisor_, product_high);
+        limb_type r0 = u0 - product_low;
+        limb_type r1 = u1 - product_high - (u0 < product_low);
+
+        while (r1 != 0 || r0 >= divisor_)
+        {
+            r1 -= r0 < divisor_;
+            r0 -= divisor_;
+        }
+
+        return static_cast<T>(r0 >> shift_);
+    }
+
+    [[nodiscard]] T multiply(T a, T b) const noexcept
+    {
+        limb_type high;
+        const limb_type low = ops::mul_wide(static_cast<limb_type>(reduce(a)),
+                                            static_cast<limb_type>(reduce(b)), high);
+        return reduce(high, low);
+    }
+
+    [[nodiscard]] T square(T a) const noexcept
+    {
+        const auto reduced = static_cast<limb_type>(reduce(a));
+        limb_type high;
+        const limb_type low = ops::mul_wide(reduced, reduced, high);
+        return reduce(high, low);
+    }
+
+private:
+    T modulus_;
+    limb_type divisor_;
+    limb_type reciprocal_;
+    unsigned shift_;
+};
+
+// Montgomery arithmetic modulo a fixed odd native modulus n with R = 2^64. Residues in Montgomery
+// form are x * R mod n; mul() and sqr() cost two multiplications and one correction each, which
+// makes this the cheapest reducer for long chains of products such as primality tests.
+template <UnsignedIntegral T>
+    requires(sizeof(T) <= sizeof(uint64_t) && !std::same_as<T, bool>)
+class MontgomeryReducer<T>
+{
+    using ops = LimbArithmetic;
+    using limb_type = LimbArithmetic::limb_type;
+
+public:
+    explicit MontgomeryReducer(T modulus)
+    {
+        if ((modulus & 1) == 0)
+            throw std::domain_error("Montgomery modulus must be positive and odd");
+
+        modulus_ = modulus;
+        const auto n = static_cast<limb_type>(modulus);
+
+        // Newton's iteration doubles the correct low bits of n^-1 mod 2^64 each round.
+        inverse_ = n;
+        for (int i = 0; i < 5; ++i)
+            inverse_ *= 2 - n * inverse_;
+
+        one_ = (limb_type(0) - n) % n;
+        limb_type high;
+        const limb_type low = ops::mul_wide(one_, one_, high);
+        ops::div_wide(high, low, n, r_squared_);
+    }
+
+    [[nodiscard]] T modulus() const noexcept { return modulus_; }
+
+    // R mod n, the Montgomery form of 1.
+    [[nodiscard]] limb_type one() const noexcept { return one_; }
+
+    [[nodiscard]] limb_type to_mont(T x) const noexcept
+    {
+        return mul(static_cast<limb_type>(x % modulus_), r_squared_);
+    }
+
+    [[nodiscard]] T from_mont(limb_type x) const noexcept { return static_cast<T>(reduce(0, x)); }
+
+    // a * b / R mod n for a, b in [0, n).
+    [[nodiscard]] limb_type mul(limb_type a, limb_type b) const noexcept
+    {
+        limb_type high;
+        const limb_type low = ops::mul_wide(a, b, high);
+        return reduce(high, low);
+    }
+
+    [[nodiscard]] limb_type sqr(limb_type a) const noexcept { return mul(a, a); }
+
+    // base^exponent mod n, taking and returning plain residues.
+    [[nodiscard]] T pow(T base, uint64_t exponent) const noexcept
+    {
+        limb_type result = one_;
+        limb_type power = to_mont(base);
+        while (exponent > 0)
+        {
+            if (exponent & 1)
+                result = mul(result, power);
+            power = sqr(power);
+            exponent >>= 1;
+        }
+        return from_mont(result);
+    }
+
+private:
+    // (high * 2^64 + low) / R mod n; requires high < n.
+    [[nodiscard]] limb_type reduce(limb_type high, limb_type low) const noexcept
+    {
+        // m * n matches low in its low limb, so the subtraction is exact and lies in (-n, n).
+        const limb_type m = low * inverse_;
+        limb_type product_high;
+        ops::mul_wide(m, static_cast<limb_type>(modulus_), product_high);
+        return high >= product_high ? high - product_high
+                                    : high - product_high + static_cast<limb_type>(modulus_);
+    }
+
+    T modulus_;
+    limb_type inverse_;
+    limb_type one_;
+    limb_type r_squared_;
+};
+
+// Residue types the span kernels below accept.
+template <typename T>
+concept ResidueLane = std::same_as<T, uint32_t> || std::same_as<T, uint64_t>;
+
+// Elementwise modular arithmetic over spans of 32- or 64-bit residues in [0, m), for RNS and NTT
+// workloads. Each call runs the best vector kernel the CPU supports on whole vectors and finishes
+// the tail with the scalar reference, which SimdLevel::Scalar selects for the whole span. Products
+// use Montgomery multiplication with R = 2^32 or 2^64 for odd moduli and Shoup's precomputed
+// quotient for a fixed multiplier; any other modulus falls back to the scalar reference. The
+// output may alias an input exactly, but must not partially overlap one.
+class ModularKernels
+{
+    using ops = LimbArithmetic;
+
+public:
+    template <typename T>
+    using Residues = std::span<std::type_identity_t<T>>;
+
+    template <typename T>
+    using ConstResidues = std::span<const std::type_identity_t<T>>;
+
+    // r[i] = (a[i] + b[i]) mod m.
+    template <ResidueLane T>
+    static void mod_add(Residues<T> r, ConstResidues<T> a, ConstResidues<T> b, T m,
+                        SimdLevel level = CpuFeatures::simd_level())
+    {
+        validate(m, r.size(), a.size(), b.size());
+        const size_t done = dispatch(level, [&](auto isa) {
+            return isa.add(r.data(), a.data(), b.data(), r.size(), m);
+        });
+        for (size_t i = done; i < r.size(); ++i)
+            r[i] = add(a[i], b[i], m);
+    }
+
+    // r[i] = (a[i] - b[i]) mod m.
+    template <ResidueLane T>
+    static void mod_sub(Residues<T> r, ConstResidues<T> a, ConstResidues<T> b, T m,
+                        SimdLevel level = CpuFeatures::simd_level())
+    {
+        validate(m, r.size(), a.size(), b.size());
+        const size_t done = dispatch(level, [&](auto isa) {
+            return isa.sub(r.data(), a.data(), b.data(), r.size(), m);
+        });
+        for (size_t i = done; i < r.size(); ++i)
+            r[i] = sub(a[i], b[i], m);
+    }
+
+    // r[i] = a[i] * b[i] mod m, by two Montgomery multiplications per element for odd m.
+    template <ResidueLane T>
+    static void mod_mul(Residues<T> r, ConstResidues<T> a, ConstResidues<T> b, T m,
+                        SimdLevel level = CpuFeatures::simd_level())
+    {
+        validate(m, r.size(), a.size(), b.size());
+        size_t done = 0;
+        if (m & 1)
+        {
+            const Montgomery<T> montgomery(m);
+            done = dispatch(level, [&](auto isa) {
+                return isa.mul(r.data(), a.data(), b.data(), r.size(), montgomery);
+            });
+        }
+        for (size_t i = done; i < r.size(); ++i)
+            r[i] = ArithmeticOperations::modular_multiply(a[i], b[i], m);
+    }
+
+    // r[i] = a[i] * w mod m for a fixed w, by Shoup's method for m up to half the lane range: one
+    // high and two low multiplications per element, with no reduction constants. w is reduced
+    // once up front, since the Shoup quotient needs w < m.
+    template <ResidueLane T>
+    static void mod_mul(Residues<T> r, ConstResidues<T> a, T w, T m,
+                        SimdLevel level = CpuFeatures::simd_level())
+    {
+        validate(m, r.size(), a.size(), a.size());
+        w %= m;
+        size_t done = 0;
+        if (m <= T(1) << (std::numeric_limits<T>::digits - 1))
+        {
+            const T quotient = shoup_quotient(w, m);
+            done = dispatch(level, [&](auto isa) {
+                return isa.mul_shoup(r.data(), a.data(), r.size(), w, quotient, m);
+            });
+        }
+        for (size_t i = done; i < r.size(); ++i)
+            r[i] = ArithmeticOperations::modular_multiply(a[i], w, m);
+    }
+
+    // r[i] = a[i]^exponent mod m. All lanes share the exponent, so they square and multiply in
+    // lockstep.
+    template <ResidueLane T>
+    static void mod_pow_batch(Residues<T> r, ConstResidues<T> a, uint64_t exponent, T m,
+                              SimdLevel level = CpuFeatures::simd_level())
+    {
+        validate(m, r.size(), a.size(), a.size());
+        size_t done = 0;
+        if (m & 1)
+        {
+            const Montgomery<T> montgomery(m);
+            done = dispatch(level, [&](auto isa) {
+                return isa.pow(r.data(), a.data(), r.size(), montgomery, exponent);
+            });
+        }
+        for (size_t i = done; i < r.size(); ++i)
+            r[i] = static_cast<T>(ArithmeticOperations::modular_pow<uint64_t>(a[i], exponent, m));
+    }
+
+private:
+    // Constants for Montgomery multiplication with R = 2^bits(T).
+    template <typename T>
+    struct Montgomery
+    {
+        T modulus;
+        T inverse;   // modulus^-1 mod R
+        T one;       // R mod modulus
+        T r_squared; // R^2 mod modulus
+
+        explicit Montgomery(T m) noexcept : modulus(m), inverse(m), one(T(0 - m) % m)
+        {
+            // Newton's iteration doubles the correct low bits of m^-1 on every step.
+            for (int i = 0; i < 5; ++i)
+                inverse *= T(2 - m * inverse);
+            r_squared = ArithmeticOperations::modular_multiply(one, one, m);
+        }
+    };
+
+    template <typename T>
+    static void validate(T m, size_t size, size_t a_size, size_t b_size)
+    {
+        if (m == 0)
+            throw std::domain_error("Modulus must be positive");
+        if (a_size != size || b_size != size)
+            throw std::invalid_argument("Residue spans must have equal sizes");
+    }
+
+    // Runs kernel with the vector unit for level and returns how many leading elements it
+    // covered; 0 when no vector unit applies.
+    template <typename Kernel>
+    static size_t dispatch(SimdLevel level, [[maybe_unused]] Kernel&& kernel)
+    {
+        switch (CpuFeatures::supported(level))
+        {
+#if defined(BIGINTEGER_SIMD_X86)
+        case SimdLevel::Avx512:
+            return kernel(Avx512{});
+        case SimdLevel::Avx2:
+            return kernel(Avx2{});
+#elif defined(BIGINTEGER_SIMD_NEON)
+        case SimdLevel::Neon:
+            return kernel(Neon{});
+#endif
+        default:
+            return 0;
+        }
+    }
+
+    template <typename T>
+    static T add(T a, T b, T m) noexcept
+    {
+        // Comparing against m - b avoids the carry out of a + b for moduli near the lane range.
+        const T t = m - b;
+        return a >= t ? a - t : a + b;
+    }
+
+    template <typename T>
+    static T sub(T a, T b, T m) noexcept
+    {
+        return a >= b ? a - b : a - b + m;
+    }
+
+    // floor(w * 2^bits(T) / m) for w < m.
+    template <typename T>
+    static T shoup_quotient(T w, T m) noexcept
+    {
+        if constexpr (sizeof(T) == 4)
+            return static_cast<T>((uint64_t(w) << 32) / m);
+        else
+        {
+            ops::limb_type remainder;
+            return ops::div_wide(w, 0, m, remainder);
+        }
+    }
+
+#if defined(BIGINTEGER_SIMD_X86)
+    struct Avx2
+    {
+        template <typename T>
+        static constexpr size_t LANES = sizeof(__m256i) / sizeof(T);
+
+        template <typename T>
+        BIGINTEGER_TARGET_AVX2 static __m256i broadcast(T x) noexcept
+        {
+            if constexpr (sizeof(T) == 4)
+                return _mm256_set1_epi32(static_cast<int>(x));
+            else
+                return _mm256_set1_epi64x(static_cast<long long>(x));
+        }
+
+        BIGINTEGER_TARGET_AVX2 static __m256i load(const void* p) noexcept
+        {
+            return _mm256_loadu_si256(static_cast<const __m256i*>(p));
+        }
+
+        BIGINTEGER_TARGET_AVX2 static void store(void* p, __m256i x) noexcept
+        {
+            _mm256_storeu_si256(static_cast<__m256i*>(p), x);
+        }
+
+        template <typename T>
+        BIGINTEGER_TARGET_AVX2 static __m256i plus(__m256i a, __m256i b) noexcept
+        {
+            if constexpr (sizeof(T) == 4)
+                return _mm256_add_epi32(a, b);
+            else
+                return _mm256_add_epi64(a, b);
+        }
+
+        template <typename T>
+        BIGINTEGER_TARGET_AVX2 static __m256i minus(__m256i a, __m256i b) noexcept
+        {
+            if constexpr (sizeof(T) == 4)
+                return _mm256_sub_epi32(a, b);
+            else
+                return _mm256_sub_epi64(a, b);
+        }
+
+        // All-ones lanes where a < b as unsigned; AVX2 only compares signed, so flip sign bits.
+        template <typename T>
+        BIGINTEGER_TARGET_AVX2 static __m256i less(__m256i a, __m256i b) noexcept
+        {
+            const __m256i sign = broadcast(T(1) << (std::numeric_limits<T>::digits - 1));
+            a = _mm256_xor_si256(a, sign);
+            b = _mm256_xor_si256(b, sign);
+            if constexpr (sizeof(T) == 4)
+                return _mm256_cmpgt_epi32(b, a);
+            else
+                return _mm256_cmpgt_epi64(b, a);
+        }
+
+        // Full lane products split into high and low halves. 64-bit lanes are assembled from
+        // four 32 x 32 -> 64-bit multiplications.
+        template <typename T>
+        BIGINTEGER_TARGET_AVX2 static __m256i mul_wide(__m256i a, __m256i b,
+                                                       __m256i& low) noexcept
+        {
+            const __m256i a_high = _mm256_srli_epi64(a, 32);
+            const __m256i b_high = _mm256_srli_epi64(b, 32);
+            if constexpr (sizeof(T) == 4)
+            {
+                const __m256i even = _mm256_mul_epu32(a, b);
+                const __m256i odd = _mm256_mul_epu32(a_high, b_high);
+                low = _mm256_blend_epi32(even, _mm256_slli_epi64(odd, 32), 0xAA);
+                return _mm256_blend_epi32(_mm256_srli_epi64(even, 32), odd, 0xAA);
+            }
+            else
+            {
+                const __m256i mask = _mm256_set1_epi64x(0xFFFFFFFF);
+                const __m256i ll = _mm256_mul_epu32(a, b);
+                const __m256i lh = _mm256_mul_epu32(a, b_high);
+                const __m256i hl = _mm256_mul_epu32(a_high, b);
+                const __m256i hh = _mm256_mul_epu32(a_high, b_high);
+                const __m256i middle =
+                    _mm256_add_epi64(_mm256_add_epi64(_mm256_srli_epi64(ll, 32),
+                                                      _mm256_and_si256(lh, mask)),
+                                     _mm256_and_si256(hl, mask));
+                low = _mm256_or_si256(_mm256_and_si256(ll, mask), _mm256_slli_epi64(middle, 32));
+                return _mm256_add_epi64(
+                    _mm256_add_epi64(hh, _mm256_srli_epi64(lh, 32)),
+                    _mm256_add_epi64(_mm256_srli_epi64(hl, 32), _mm256_srli_epi64(middle, 32)));
+            }
+        }
+
+        template <typename T>
+        BIGINTEGER_TARGET_AVX2 static __m256i mul_low(__m256i a, __m256i b) noexcept
+        {
+            if constexpr (sizeof(T) == 4)
+                return _mm256_mullo_epi32(a, b);
+            else
+            {
+                const __m256i cross =
+                    _mm256_add_epi64(_mm256_mul_epu32(a, _mm256_srli_epi64(b, 32)),
+                                     _mm256_mul_epu32(_mm256_srli_epi64(a, 32), b));
+                return _mm256_add_epi64(_mm256_mul_epu32(a, b), _mm256_slli_epi64(cross, 32));
+            }
+        }
+
+        template <typename T>
+        BIGINTEGER_TARGET_AVX2 static __m256i mul_high(__m256i a, __m256i b) noexcept
+        {
+            __m256i low;
+            return mul_wide<T>(a, b, low);
+        }
+
+        // a * b / R mod n, where the low halves of a * b and q * n cancel exactly.
+        template <typename T>
+        BIGINTEGER_TARGET_AVX2 static __m256i montgomery(__m256i a, __m256i b, __m256i n,
+                                                         __m256i inverse) noexcept
+        {
+            __m256i low;
+            const __m256i high = mul_wide<T>(a, b, low);
+            const __m256i q_high = mul_high<T>(mul_low<T>(low, inverse), n);
+            return plus<T>(minus<T>(high, q_high), _mm256_and_si256(less<T>(high, q_high), n));
+        }
+
+        template <typename T>
+        BIGINTEGER_TARGET_AVX2 static size_t add(T* r, const T* a, const T* b, size_t n,
+                                                 T m) noexcept
+        {
+            const __m256i modulus = broadcast(m);
+            size_t i = 0;
+            for (; i + LANES<T> <= n; i += LANES<T>)
+            {
+                const __m256i x = load(a + i);
+                const __m256i y = load(b + i);
+                const __m256i t = minus<T>(modulus, y);
+                store(r + i, _mm256_blendv_epi8(minus<T>(x, t), plus<T>(x, y), less<T>(x, t)));
+            }
+            return i;
+        }
+
+        template <typename T>
+        BIGINTEGER_TARGET_AVX2 static size_t sub(T* r, const T* a, const T* b, size_t n,
+                                                 T m) noexcept
+        {
+            const __m256i modulus = broadcast(m);
+            size_t i = 0;
+            for (; i + LANES<T> <= n; i += LANES<T>)
+            {
+                const __m256i x = load(a + i);
+                const __m256i y = load(b + i);
+                const __m256i borrow = _mm256_and_si256(less<T>(x, y), modulus);
+                store(r + i, plus<T>(minus<T>(x, y), borrow));
+            }
+            return i;
+        }
+
+        template <typename T>
+        BIGINTEGER_TARGET_AVX2 static size_t mul(T* r, const T* a, const T* b, size_t n,
+                                                 const Montgomery<T>& p) noexcept
+        {
+            const __m256i modulus = broadcast(p.modulus);
+            const __m256i inverse = broadcast(p.inverse);
+            const __m256i r_squared = broadcast(p.r_squared);
+            size_t i = 0;
+            for (; i + LANES<T> <= n; i += LANES<T>)
+            {
+                const __m256i x = montgomery<T>(load(a + i), load(b + i), modulus, inverse);
+                store(r + i, montgomery<T>(x, r_squared, modulus, inverse));
+            }
+            return i;
+        }
+
+        template <typename T>
+        BIGINTEGER_TARGET_AVX2 static size_t mul_shoup(T* r, const T* a, size_t n, T w,
+                                                       T quotient, T m) noexcept
+        {
+            const __m256i modulus = broadcast(m);
+            const __m256i factor = broadcast(w);
+            const __m256i factor_quotient = broadcast(quotient);
+            size_t i = 0;
+            for (; i + LANES<T> <= n; i += LANES<T>)
+            {
+                const __m256i x = load(a + i);
+                const __m256i q = mul_high<T>(x, factor_quotient);
+                const __m256i y = minus<T>(mul_low<T>(x, factor), mul_low<T>(q, modulus));
+                store(r + i, minus<T>(y, _mm256_andnot_si256(less<T>(y, modulus), modulus)));
+            }
+            return i;
+        }
+
+        template <typename T>
+        BIGINTEGER_TARGET_AVX2 static size_t pow(T* r, const T* a, size_t n,
+                                                 const Montgomery<T>& p,
+                                                 uint64_t exponent) noexcept
+        {
+            size_t i = 0;
+            for (; i + 4 * LANES<T> <= n; i += 4 * LANES<T>)
+                pow_block<T, 4>(r + i, a + i, p, exponent);
+            for (; i + LANES<T> <= n; i += LANES<T>)
+                pow_block<T, 1>(r + i, a + i, p, exponent);
+            return i;
+        }
+
+        // Raises COUNT consecutive vectors in lockstep so that their independent multiplications
+        // hide each other's latency.
+        template <typename T, size_t COUNT>
+        BIGINTEGER_TARGET_AVX2 static void pow_block(T* r, const T* a, const Montgomery<T>& p,
+                                                     uint64_t exponent) noexcept
+        {
+            const __m256i modulus = broadcast(p.modulus);
+            const __m256i inverse = broadcast(p.inverse);
+            const __m256i r_squared = broadcast(p.r_squared);
+            __m256i x[COUNT];
+            __m256i result[COUNT];
+            for (size_t k = 0; k < COUNT; ++k)
+            {
+                x[k] = montgomery<T>(load(a + k * LANES<T>), r_squared, modulus, inverse);
+                result[k] = exponent == 0 ? broadcast(p.one) : x[k];
+            }
+
+            for (int bit = static_cast<int>(std::bit_width(exponent)) - 2; bit >= 0; --bit)
+            {
+                for (size_t k = 0; k < COUNT; ++k)
+                    result[k] = montgomery<T>(result[k], result[k], modulus, inverse);
+                if ((exponent >> bit) & 1)
+                    for (size_t k = 0; k < COUNT; ++k)
+                        result[k] = montgomery<T>(result[k], x[k], modulus, inverse);
+            }
+
+            const __m256i one = broadcast(T(1));
+            for (size_t k = 0; k < COUNT; ++k)
+                store(r + k * LANES<T>, montgomery<T>(result[k], one, modulus, inverse));
+        }
+    };
+
+// GCC 12 flags the self-initialised placeholder inside its own AVX-512 shift and multiply
+// intrinsics as uninitialised.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+    struct Avx512
+    {
+        template <typename T>
+        static constexpr size_t LANES = sizeof(__m512i) / sizeof(T);
+
+        template <typename T>
+        BIGINTEGER_TARGET_AVX512 static __m512i broadcast(T x) noexcept
+        {
+            if constexpr (sizeof(T) == 4)
+                return _mm512_set1_epi32(static_cast<int>(x));
+            else
+                return _mm512_set1_epi64(static_cast<long long>(x));
+        }
+
+        BIGINTEGER_TARGET_AVX512 static __m512i load(const void* p) noexcept
+        {
+            return _mm512_loadu_si512(p);
+        }
+
+        BIGINTEGER_TARGET_AVX512 static void store(void* p, __m512i x) noexcept
+        {
+            _mm512_storeu_si512(p, x);
+        }
+
+        template <typename T>
+        BIGINTEGER_TARGET_AVX512 static __m512i plus(__m512i a, __m512i b) noexcept
+        {
+            if constexpr (sizeof(T) == 4)
+                return _mm512_add_epi32(a, b);
+            else
+                return _mm512_add_epi64(a, b);
+        }
+
+        template <typename T>
+        BIGINTEGER_TARGET_AVX512 static __m512i minus(__m512i a, __m512i b) noexcept
+        {
+            if constexpr (sizeof(T) == 4)
+                return _mm512_sub_epi32(a, b);
+            else
+                return _mm512_sub_epi64(a, b);
+        }
+
+        // a + (b where a < b as unsigned), the usual correction of a wrapped difference.
+        template <typename T>
+        BIGINTEGER_TARGET_AVX512 static __m512i add_if_less(__m512i x, __m512i a, __m512i b,
+                                                            __m512i addend) noexcept
+        {
+            if constexpr (sizeof(T) == 4)
+                return _mm512_mask_add_epi32(x, _mm512_cmplt_epu32_mask(a, b), x, addend);
+            else
+                return _mm512_mask_add_epi64(x, _mm512_cmplt_epu64_mask(a, b), x, addend);
+        }
+
+        template <typename T>
+        BIGINTEGER_TARGET_AVX512 static __m512i mul_wide(__m512i a, __m512i b,
+                                                         __m512i& low) noexcept
+        {
+            const __m512i a_high = _mm512_srli_epi64(a, 32);
+            const __m512i b_high = _mm512_srli_epi64(b, 32);
+            if constexpr (sizeof(T) == 4)
+            {
+                const __m512i even = _mm512_mul_epu32(a, b);
+                const __m512i odd = _mm512_mul_epu32(a_high, b_high);
+                low = _mm512_mask_blend_epi32(0xAAAA, even, _mm512_slli_epi64(odd, 32));
+                return _mm512_mask_blend_epi32(0xAAAA, _mm512_srli_epi64(even, 32), odd);
+            }
+            else
+            {
+                const __m512i mask = _mm512_set1_epi64(0xFFFFFFFF);
+                const __m512i ll = _mm512_mul_epu32(a, b);
+                const __m512i lh = _mm512_mul_epu32(a, b_high);
+                const __m512i hl = _mm512_mul_epu32(a_high, b);
+                const __m512i hh = _mm512_mul_epu32(a_high, b_high);
+                const __m512i middle =
+                    _mm512_add_epi64(_mm512_add_epi64(_mm512_srli_epi64(ll, 32),
+                                                      _mm512_and_si512(lh, mask)),
+                                     _mm512_and_si512(hl, mask));
+                low = _mm512_or_si512(_mm512_and_si512(ll, mask), _mm512_slli_epi64(middle, 32));
+                return _mm512_add_epi64(
+                    _mm512_add_epi64(hh, _mm512_srli_epi64(lh, 32)),
+                    _mm512_add_epi64(_mm512_srli_epi64(hl, 32), _mm512_srli_epi64(middle, 32)));
+            }
+        }
+
+        template <typename T>
+        BIGINTEGER_TARGET_AVX512 static __m512i mul_low(__m512i a, __m512i b) noexcept
+        {
+            if constexpr (sizeof(T) == 4)
+                return _mm512_mullo_epi32(a, b);
+            else
+                return _mm512_mullo_epi64(a, b);
+        }
+
+        template <typename T>
+        BIGINTEGER_TARGET_AVX512 static __m512i mul_high(__m512i a, __m512i b) noexcept
+        {
+            __m512i low;
+            return mul_wide<T>(a, b, low);
+        }
+
+        template <typename T>
+        BIGINTEGER_TARGET_AVX512 static __m512i montgomery(__m512i a, __m512i b, __m512i n,
+                                                           __m512i inverse) noexcept
+        {
+            __m512i low;
+            const __m512i high = mul_wide<T>(a, b, low);
+            const __m512i q_high = mul_high<T>(mul_low<T>(low, inverse), n);
+            return add_if_less<T>(minus<T>(high, q_high), high, q_high, n);
+        }
+
+        template <typename T>
+        BIGINTEGER_TARGET_AVX512 static size_t add(T* r, const T* a, const T* b, size_t n,
+                                                   T m) noexcept
+        {
+            const __m512i modulus = broadcast(m);
+            size_t i = 0;
+            for (; i + LANES<T> <= n; i += LANES<T>)
+            {
+                const __m512i x = load(a + i);
+                const __m512i y = load(b + i);
+                const __m512i t = minus<T>(modulus, y);
+                // x - t wraps exactly when x < t, and adding m back yields x + y.
+                store(r + i, add_if_less<T>(minus<T>(x, t), x, t, modulus));
+            }
+            return i;
+        }
+
+        template <typename T>
+        BIGINTEGER_TARGET_AVX512 static size_t sub(T* r, const T* a, const T* b, size_t n,
+                                                   T m) noexcept
+        {
+            const __m512i modulus = broadcast(m);
+            size_t i = 0;
+            for (; i + LANES<T> <= n; i += LANES<T>)
+            {
+                const __m512i x = load(a + i);
+                const __m512i y = load(b + i);
+                store(r + i, add_if_less<T>(minus<T>(x, y), x, y, modulus));
+            }
+            return i;
+        }
+
+        template <typename T>
+        BIGINTEGER_TARGET_AVX512 static size_t mul(T* r, const T* a, const T* b, size_t n,
+                                                   const Montgomery<T>& p) noexcept
+        {
+            const __m512i modulus = broadcast(p.modulus);
+            const __m512i inverse = broadcast(p.inverse);
+            const __m512i r_squared = broadcast(p.r_squared);
+            size_t i = 0;
+            for (; i + LANES<T> <= n; i += LANES<T>)
+            {
+                const __m512i x = montgomery<T>(load(a + i), load(b + i), modulus, inverse);
+                store(r + i, montgomery<T>(x, r_squared, modulus, inverse));
+            }
+            return i;
+        }
+
+        template <typename T>
+        BIGINTEGER_TARGET_AVX512 static size_t mul_shoup(T* r, const T* a, size_t n, T w,
+                                                         T quotient, T m) noexcept
+        {
+            const __m512i modulus = broadcast(m);
+            const __m512i factor = broadcast(w);
+            const __m512i factor_quotient = broadcast(quotient);
+            size_t i = 0;
+            for (; i + LANES<T> <= n; i += LANES<T>)
+            {
+                const __m512i x = load(a + i);
+                const __m512i q = mul_high<T>(x, factor_quotient);
+                const __m512i y = minus<T>(mul_low<T>(x, factor), mul_low<T>(q, modulus));
+                // y < 2m, and y - m wraps above y exactly when y < m.
+                if constexpr (sizeof(T) == 4)
+                    store(r + i, _mm512_min_epu32(y, minus<T>(y, modulus)));
+                else
+                    store(r + i, _mm512_min_epu64(y, minus<T>(y, modulus)));
+            }
+            return i;
+        }
+
+        template <typename T>
+        BIGINTEGER_TARGET_AVX512 static size_t pow(T* r, const T* a, size_t n,
+                                                   const Montgomery<T>& p,
+                                                   uint64_t exponent) noexcept
+        {
+            size_t i = 0;
+            for (; i + 4 * LANES<T> <= n; i += 4 * LANES<T>)
+                pow_block<T, 4>(r + i, a + i, p, exponent);
+            for (; i + LANES<T> <= n; i += LANES<T>)
+                pow_block<T, 1>(r + i, a + i, p, exponent);
+            return i;
+        }
+
+        // Raises COUNT consecutive vectors in lockstep so that their independent multiplications
+        // hide each other's latency.
+        template <typename T, size_t COUNT>
+        BIGINTEGER_TARGET_AVX512 static void pow_block(T* r, const T* a, const Montgomery<T>& p,
+                                                       uint64_t exponent) noexcept
+        {
+            const __m512i modulus = broadcast(p.modulus);
+            const __m512i inverse = broadcast(p.inverse);
+            const __m512i r_squared = broadcast(p.r_squared);
+            __m512i x[COUNT];
+            __m512i result[COUNT];
+            for (size_t k = 0; k < COUNT; ++k)
+            {
+                x[k] = montgomery<T>(load(a + k * LANES<T>), r_squared, modulus, inverse);
+                result[k] = exponent == 0 ? broadcast(p.one) : x[k];
+            }
+
+            for (int bit = static_cast<int>(std::bit_width(exponent)) - 2; bit >= 0; --bit)
+            {
+                for (size_t k = 0; k < COUNT; ++k)
+                    result[k] = montgomery<T>(result[k], result[k], modulus, inverse);
+                if ((exponent >> bit) & 1)
+                    for (size_t k = 0; k < COUNT; ++k)
+                        result[k] = montgomery<T>(result[k], x[k], modulus, inverse);
+            }
+
+            const __m512i one = broadcast(T(1));
+            for (size_t k = 0; k < COUNT; ++k)
+                store(r + k * LANES<T>, montgomery<T>(result[k], one, modulus, inverse));
+        }
+    };
+#pragma GCC diagnostic pop
+#elif defined(BIGINTEGER_SIMD_NEON)
+    // 128-bit NEON has no 64 x 64-bit multiplication, so 64-bit products stay scalar.
+    struct Neon
+    {
+        template <typename T>
+        static constexpr size_t LANES = 16 / sizeof(T);
+
+        static uint32x4_t mul_high(uint32x4_t a, uint32x4_t b) noexcept
+        {
+            const uint64x2_t low = vmull_u32(vget_low_u32(a), vget_low_u32(b));
+            const uint64x2_t high = vmull_high_u32(a, b);
+            return vuzp2q_u32(vreinterpretq_u32_u64(low), vreinterpretq_u32_u64(high));
+        }
+
+        static uint32x4_t montgomery(uint32x4_t a, uint32x4_t b, uint32x4_t n,
+                                     uint32x4_t inverse) noexcept
+        {
+            const uint32x4_t high = mul_high(a, b);
+            const uint32x4_t q_high = mul_high(vmulq_u32(vmulq_u32(a, b), inverse), n);
+            const uint32x4_t borrow = vandq_u32(vcltq_u32(high, q_high), n);
+            return vaddq_u32(vsubq_u32(high, q_high), borrow);
+        }
+
+        template <typename T>
+        static size_t add(T* r, const T* a, const T* b, size_t n, T m) noexcept
+        {
+            size_t i = 0;
+            if constexpr (sizeof(T) == 4)
+            {
+                const uint32x4_t modulus = vdupq_n_u32(m);
+                for (; i + LANES<T> <= n; i += LANES<T>)
+                {
+                    const uint32x4_t x = vld1q_u32(a + i);
+                    const uint32x4_t y = vld1q_u32(b + i);
+                    const uint32x4_t t = vsubq_u32(modulus, y);
+                    const uint32x4_t wrapped = vcltq_u32(x, t);
+                    vst1q_u32(r + i, vbslq_u32(wrapped, vaddq_u32(x, y), vsubq_u32(x, t)));
+                }
+            }
+            else
+            {
+                const uint64x2_t modulus = vdupq_n_u64(m);
+                for (; i + LANES<T> <= n; i += LANES<T>)
+                {
+                    const uint64x2_t x = vld1q_u64(a + i);
+                    const uint64x2_t y = vld1q_u64(b + i);
+                    const uint64x2_t t = vsubq_u64(modulus, y);
+                    const uint64x2_t wrapped = vcltq_u64(x, t);
+                    vst1q_u64(r + i, vbslq_u64(wrapped, vaddq_u64(x, y), vsubq_u64(x, t)));
+                }
+            }
+            return i;
+        }
+
+        template <typename T>
+        static size_t sub(T* r, const T* a, const T* b, size_t n, T m) noexcept
+        {
+            size_t i = 0;
+            if constexpr (sizeof(T) == 4)
+            {
+                const uint32x4_t modulus = vdupq_n_u32(m);
+                for (; i + LANES<T> <= n; i += LANES<T>)
+                {
+                    const uint32x4_t x = vld1q_u32(a + i);
+                    const uint32x4_t y = vld1q_u32(b + i);
+                    const uint32x4_t borrow = vandq_u32(vcltq_u32(x, y), modulus);
+                    vst1q_u32(r + i, vaddq_u32(vsubq_u32(x, y), borrow));
+                }
+            }
+            else
+            {
+                const uint64x2_t modulus = vdupq_n_u64(m);
+                for (; i + LANES<T> <= n; i += LANES<T>)
+                {
+                    const uint64x2_t x = vld1q_u64(a + i);
+                    const uint64x2_t y = vld1q_u64(b + i);
+                    const uint64x2_t borrow = vandq_u64(vcltq_u64(x, y), modulus);
+                    vst1q_u64(r + i, vaddq_u64(vsubq_u64(x, y), borrow));
+                }
+            }
+            return i;
+        }
+
+        template <typename T>
+        static size_t mul(T* r, const T* a, const T* b, size_t n, const Montgomery<T>& p) noexcept
+        {
+            size_t i = 0;
+            if constexpr (sizeof(T) == 4)
+            {
+                const uint32x4_t modulus = vdupq_n_u32(p.modulus);
+                const uint32x4_t inverse = vdupq_n_u32(p.inverse);
+                const uint32x4_t r_squared = vdupq_n_u32(p.r_squared);
+                for (; i + LANES<T> <= n; i += LANES<T>)
+                {
+                    const uint32x4_t x =
+                        montgomery(vld1q_u32(a + i), vld1q_u32(b + i), modulus, inverse);
+                    vst1q_u32(r + i, montgomery(x, r_squared, modulus, inverse));
+                }
+            }
+            return i;
+        }
+
+        template <typename T>
+        static size_t mul_shoup(T* r, const T* a, size_t n, T w, T quotient, T m) noexcept
+        {
+            size_t i = 0;
+            if constexpr (sizeof(T) == 4)
+            {
+                const uint32x4_t modulus = vdupq_n_u32(m);
+                const uint32x4_t factor = vdupq_n_u32(w);
+                const uint32x4_t factor_quotient = vdupq_n_u32(quotient);
+                for (; i + LANES<T> <= n; i += LANES<T>)
+                {
+                    const uint32x4_t x = vld1q_u32(a + i);
+                    const uint32x4_t q = mul_high(x, factor_quotient);
+                    const uint32x4_t y = vsubq_u32(vmulq_u32(x, factor), vmulq_u32(q, modulus));
+                    vst1q_u32(r + i, vminq_u32(y, vsubq_u32(y, modulus)));
+                }
+            }
+            return i;
+        }
+
+        template <typename T>
+        static size_t pow(T* r, const T* a, size_t n, const Montgomery<T>& p,
+                          uint64_t exponent) noexcept
+        {
+            size_t i = 0;
+            if constexpr (sizeof(T) == 4)
+            {
+                for (; i + 4 * LANES<T> <= n; i += 4 * LANES<T>)
+                    pow_block<4>(r + i, a + i, p, exponent);
+                for (; i + LANES<T> <= n; i += LANES<T>)
+                    pow_block<1>(r + i, a + i, p, exponent);
+            }
+            return i;
+        }
+
+        template <size_t COUNT>
+        static void pow_block(uint32_t* r, const uint32_t* a, const Montgomery<uint32_t>& p,
+                              uint64_t exponent) noexcept
+        {
+            const uint32x4_t modulus = vdupq_n_u32(p.modulus);
+            const uint32x4_t inverse = vdupq_n_u32(p.inverse);
+            const uint32x4_t r_squared = vdupq_n_u32(p.r_squared);
+            uint32x4_t x[COUNT];
+            uint32x4_t result[COUNT];
+            for (size_t k = 0; k < COUNT; ++k)
+            {
+                x[k] = montgomery(vld1q_u32(a + 4 * k), r_squared, modulus, inverse);
+                result[k] = exponent == 0 ? vdupq_n_u32(p.one) : x[k];
+            }
+
+            for (int bit = static_cast<int>(std::bit_width(exponent)) - 2; bit >= 0; --bit)
+            {
+                for (size_t k = 0; k < COUNT; ++k)
+                    result[k] = montgomery(result[k], result[k], modulus, inverse);
+                if ((exponent >> bit) & 1)
+                    for (size_t k = 0; k < COUNT; ++k)
+                        result[k] = montgomery(result[k], x[k], modulus, inverse);
+            }
+
+            const uint32x4_t one = vdupq_n_u32(1);
+            for (size_t k = 0; k < COUNT; ++k)
+                vst1q_u32(r + 4 * k, montgomery(result[k], one, modulus, inverse));
+        }
+    };
+#endif
+};
+
+// Barrett reduction modulo a fixed positive BigInteger m of k bits, with mu = floor(4^k / m)
+// computed once through NewtonRaphsonDivision. Values below 4^k, such as products of residues,
+// are reduced with two multiplications; anything else falls back to a plain division.
+template <size_t N>
+class BarrettReducer<BasicBigInteger<N>>
+{
+public:
+    using integer_type = BasicBigInteger<N>;
+
+    explicit BarrettReducer(const integer_type& modulus) : modulus_(modulus)
+    {
+        if (modulus.sign() <= 0)
+            throw std::domain_error("Modulus must be positive");
+
+        bits_ = modulus.bit_length();
+        mu_ = NewtonRaphsonDivision::reciprocal(modulus, 2 * bits_);
+    }
+
+    [[nodiscard]] const integer_type& modulus() const noexcept { return modulus_; }
+
+    // Non-negative residue of x mod m.
+    [[nodiscard]] integer_type reduce(const integer_type& x) const
+    {
+        if (x.is_negative() || x.bit_length() > 2 * bits_)
+        {
+            integer_type r = x % modulus_;
+            return r.is_negative() ? r + modulus_ : r;
+        }
+
+        const integer_type q = ((x >> (bits_ - 1)) * mu_) >> (bits_ + 1);
+        integer_type r = x - q * modulus_;
+        while (r >= modulus_)
+            r -= modulus_;
+        return r;
+    }
+
+    // a * b mod m for a, b in [0, m).
+    [[nodiscard]] integer_type multiply(const integer_type& a, const integer_type& b) const
+    {
+        return reduce(&a == &b ? a.square() : a * b);
+    }
+
+    // a^2 mod m for a in [0, m).
+    [[nodiscard]] integer_type square(const integer_type& a) const { return reduce(a.square()); }
+
+private:
+    integer_type modulus_;
+    integer_type mu_;
+    size_t bits_ = 0;
+};
+
+// Montgomery arithmetic modulo a fixed odd N of n limbs, with R = 2^(64n). Values in Montgomery
+// form are residues x * R mod N; mul() and sqr() return a * b / R mod N, so products stay in form
+// without any division. The limb-level overloads work on n-limb spans with caller-provided
+// scratch, so exponentiation loops can keep every intermediate in preallocated buffers.
+template <size_t InlineLimbs>
+class MontgomeryContext
+{
+    using ops = LimbArithmetic;
+
+public:
+    using limb_type = LimbArithmetic::limb_type;
+    using integer_type = BasicBigInteger<InlineLimbs>;
+
+    explicit MontgomeryContext(const integer_type& modulus) : modulus_(modulus)
+    {
+        if (modulus.sign() <= 0 || modulus.is_even())
+            throw std::domain_error("Montgomery modulus must be positive and odd");
+
+        size_ = modulus.limb_count();
+        modulus_limbs_.assign(modulus.limbs().begin(), modulus.limbs().end());
+
+        // Newton's iteration doubles the correct low bits of N^-1 mod 2^64 on every step.
+        const limb_type low = modulus_limbs_[0];
+        limb_type inverse = low;
+        for (int i = 0; i < 5; ++i)
+            inverse *= 2 - low * inverse;
+        neg_inverse_ = 0 - inverse;
+
+        const size_t r_bits = size_ * LimbArithmetic::LIMB_BITS;
+        one_ = padded((integer_type(1) << r_bits) % modulus);
+        r_squared_ = padded((integer_type(1) << (2 * r_bits)) % modulus);
+    }
+
+    [[nodiscard]] const integer_type& modulus() const noexcept { return modulus_; }
+
+    // Limb count n of the modulus and of every value in Montgomery form.
+    [[nodiscard]] size_t size() const noexcept { return size_; }
+
+    // Scratch limbs needed by the limb-level operations.
+    [[nodiscard]] size_t scratch_size() const noexcept { return 2 * size_ + 2; }
+
+    // -N^-1 mod 2^64.
+    [[nodiscard]] limb_type neg_inverse() const noexcept { return neg_inverse_; }
+
+    // R mod N, the Montgomery form of 1.
+    [[nodiscard]] integer_type one() const { return integer(one_.data()); }
+
+    // x * R mod N for any integer x.
+    [[nodiscard]] integer_type to_mont(const integer_type& x) const
+    {
+        integer_type reduced = x % modulus_;
+        if (reduced.is_negative())
+            reduced += modulus_;
+        return mul(reduced, integer(r_squared_.data()));
+    }
+
+    // x / R mod N for x in [0, N).
+    [[nodiscard]] integer_type from_mont(const integer_type& x) const
+    {
+        LimbStorage<InlineLimbs> buffer;
+        buffer.resize(size_ + scratch_size());
+        load(buffer.data(), x);
+        from_mont(buffer.data(), buffer.data(), buffer.data() + size_);
+        return integer(buffer.data());
+    }
+
+    // a * b / R mod N for a, b in [0, N).
+    [[nodiscard]] integer_type mul(const integer_type& a, const integer_type& b) const
+    {
+        LimbStorage<InlineLimbs> buffer;
+        buffer.resize(2 * size_ + scratch_size());
+        load(buffer.data(), a);
+        load(buffer.data() + size_, b);
+        mul(buffer.data(), buffer.data(), buffer.data() + size_, buffer.data() + 2 * size_);
+        return integer(buffer.data());
+    }
+
+    // a^2 / R mod N for a in [0, N).
+    [[nodiscard]] integer_type sqr(const integer_type& a) const
+    {
+        LimbStorage<InlineLimbs> buffer;
+        buffer.resize(size_ + scratch_size());
+        load(buffer.data(), a);
+        sqr(buffer.data(), buffer.data(), buffer.data() + size_);
+        return integer(buffer.data());
+    }
+
+    // base^exponent mod N for a non-negative exponent, in normal (not Montgomery) form. Runs
+    // sliding-window exponentiation over precomputed odd powers, with every squaring on the
+    // dedicated kernel and all intermediates in one preallocated buffer. With the ConstantTime
+    // policy it runs fixed windows over every limb of the exponent instead.
+    template <typename Policy = VariableTime>
+    [[nodiscard]] integer_type pow(const integer_type& base, const integer_type& exponent) const
+    {
+        if (exponent.is_negative())
+            throw std::domain_error("Exponent must be non-negative");
+        if constexpr (std::is_same_v<Policy, ConstantTime>)
+            return pow_constant_time(base, exponent);
+
+        const size_t n = size_;
+        const size_t window = ArithmeticOperations::exponent_window_size(exponent.bit_length());
+        const size_t table_size = size_t(1) << (window - 1);
+
+        LimbStorage<InlineLimbs> buffer;
+        buffer.resize((table_size + 2) * n + scratch_size());
+        limb_type* table = buffer.data();
+        limb_type* square = table + table_size * n;
+        limb_type* result = square + n;
+        limb_type* scratch = result + n;
+
+        integer_type reduced = base % modulus_;
+        if (reduced.is_negative())
+            reduced += modulus_;
+        load(table, reduced);
+        to_mont(table, table, scratch);
+        if (table_size > 1)
+        {
+            sqr(square, table, scratch);
+            for (size_t k = 1; k < table_size; ++k)
+                mul(table + k * n, table + (k - 1) * n, square, scratch);
+        }
+
+        bool started = false;
+        ArithmeticOperations::sliding_window(
+            exponent, window,
+            [&] {
+                if (started)
+                    sqr(result, result, scratch);
+            },
+            [&](size_t odd) {
+                const limb_type* power = table + (odd / 2) * n;
+                if (started)
+                    mul(result, result, power, scratch);
+                else
+                    std::copy(power, power + n, result);
+                started = true;
+            });
+
+        if (!started)
+            return integer_type(1) % modulus_;
+
+        from_mont(result, result, scratch);
+        return integer(result);
+    }
+
+    // r[0..n) = a * b / R mod N by coarsely integrated operand scanning (CIOS): each limb of a
+    // is multiplied in and one limb of reduction is folded into the same pass, so the
+    // accumulator never exceeds n + 2 limbs. r may alias a or b.
+    void mul(limb_type* r, const limb_type* a, const limb_type* b,
+             limb_type* scratch) const noexcept
+    {
+        const size_t n = size_;
+        const limb_type* m = modulus_limbs_.data();
+        limb_type* t = scratch;
+        std::fill(t, t + n + 2, limb_type(0));
+
+        for (size_t i = 0; i < n; ++i)
+        {
+            limb_type carry = ops::addmul_1(t, b, n, a[i]);
+            t[n] += carry;
+            t[n + 1] = t[n] < carry;
+
+            // t + q * N is divisible by 2^64; shifting down by one limb happens in the same loop.
+            const limb_type q = t[0] * neg_inverse_;
+            limb_type high;
+            limb_type low = ops::mul_wide(q, m[0], high);
+            carry = high + (t[0] + low < low);
+            for (size_t j = 1; j < n; ++j)
+            {
+                low = ops::mul_wide(q, m[j], high);
+                low += carry;
+                high += low < carry;
+                t[j - 1] = t[j] + low;
+                carry = high + (t[j - 1] < low);
+            }
+            t[n - 1] = t[n] + carry;
+            t[n] = t[n + 1] + (t[n - 1] < carry);
+        }
+
+        final_subtract(r, t, t[n]);
+    }
+
+    // r[0..n) = a^2 / R mod N using the dedicated squaring kernel followed by word-by-word
+    // reduction. r may alias a.
+    void sqr(limb_type* r, const limb_type* a, limb_type* scratch) const
+    {
+        Multiplication::square(scratch, a, size_);
+        reduce(r, scratch);
+    }
+
+    void to_mont(limb_type* r, const limb_type* a, limb_type* scratch) const noexcept
+    {
+        mul(r, a, r_squared_.data(), scratch);
+    }
+
+    void from_mont(limb_type* r, const limb_type* a, limb_type* scratch) const noexcept
+    {
+        std::copy(a, a + size_, scratch);
+        std::fill(scratch + size_, scratch + 2 * size_, limb_type(0));
+        reduce(r, scratch);
+    }
+
+    // r[0..n) = t / R mod N for t[0..2n) < N * R; t is clobbered.
+    void reduce(limb_type* r, limb_type* t) const noexcept
+    {
+        const size_t n = size_;
+        limb_type carry = 0;
+        for (size_t i = 0; i < n; ++i)
+        {
+            const limb_type q = t[i] * neg_inverse_;
+            const limb_type high = ops::addmul_1(t + i, modulus_limbs_.data(), n, q);
+
+            const limb_type sum = t[i + n] + high;
+            limb_type next = sum < high;
+            t[i + n] = sum + carry;
+            next += t[i + n] < carry;
+            carry = next;
+        }
+
+        final_subtract(r, t + n, carry);
+    }
+
+    // r = a + b mod N for a, b in [0, N). r may alias a or b.
+    void add(limb_type* r, const limb_type* a, const limb_type* b,
+             limb_type* scratch) const noexcept
+    {
+        const limb_type carry = ops::add_n(scratch, a, b, size_);
+        final_subtract(r, scratch, carry);
+    }
+
+    // r = a - b mod N for a, b in [0, N). r may alias a or b.
+    void sub(limb_type* r, const limb_type* a, const limb_type* b) const noexcept
+    {
+        if (ops::sub_n(r, a, b, size_) != 0)
+            ops::add_n(r, r, modulus_limbs_.data(), size_);
+    }
+
+    // r = a / 2 mod N for a in [0, N), adding N first when a is odd. r may alias a.
+    void half(limb_type* r, const limb_type* a) const noexcept
+    {
+        limb_type carry = 0;
+        if (a[0] & 1)
+            carry = ops::add_n(r, a, modulus_limbs_.data(), size_);
+        else
+            std::copy(a, a + size_, r);
+        ops::rshift(r, r, size_, 1);
+        r[size_ - 1] |= carry << (LimbArithmetic::LIMB_BITS - 1);
+    }
+
+private:
+    // Fixed-window exponentiation: every window of the zero-padded exponent costs the same
+    // squarings and one multiplication by a table entry picked with a masked scan over all
+    // 2^w powers, so neither branches nor addresses depend on the exponent's bits. Squarings
+    // use CIOS rather than the squaring kernel, whose subquadratic layers branch on operands.
+    [[nodiscard]] integer_type pow_constant_time(const integer_type& base,
+                                                 const integer_type& exponent) const
+    {
+        const size_t n = size_;
+        const auto digits = exponent.limbs();
+        const size_t bits = digits.size() * LimbArithmetic::LIMB_BITS;
+        const size_t window = ArithmeticOperations::exponent_window_size(bits);
+        const size_t table_size = size_t(1) << window;
+
+        LimbStorage<InlineLimbs> buffer;
+        buffer.resize((table_size + 2) * n + scratch_size());
+        limb_type* table = buffer.data();
+        limb_type* power = table + table_size * n;
+        limb_type* result = power + n;
+        limb_type* scratch = result + n;
+
+        integer_type reduced = base % modulus_;
+        if (reduced.is_negative())
+            reduced += modulus_;
+        std::copy(one_.begin(), one_.end(), table);
+        load(table + n, reduced);
+        to_mont(table + n, table + n, scratch);
+        for (size_t k = 2; k < table_size; ++k)
+            mul(table + k * n, table + (k - 1) * n, table + n, scratch);
+
+        std::copy(one_.begin(), one_.end(), result);
+        for (size_t position = bits; position > 0;)
+        {
+            const size_t width = position % window == 0 ? window : position % window;
+            position -= width;
+            for (size_t i = 0; i < width; ++i)
+                mul(result, result, result, scratch);
+
+            const size_t index = position / LimbArithmetic::LIMB_BITS;
+            const size_t offset = position % LimbArithmetic::LIMB_BITS;
+            limb_type digit = digits[index] >> offset;
+            if (offset + width > LimbArithmetic::LIMB_BITS)
+                digit |= digits[index + 1] << (LimbArithmetic::LIMB_BITS - offset);
+            digit &= (limb_type(1) << width) - 1;
+
+            std::fill(power, power + n, limb_type(0));
+            for (size_t k = 0; k < table_size; ++k)
+            {
+                const limb_type difference = k ^ digit;
+                const limb_type mask = ((difference | (0 - difference)) >> 63) - 1;
+                for (size_t j = 0; j < n; ++j)
+                    power[j] |= table[k * n + j] & mask;
+            }
+            mul(result, result, power, scratch);
+        }
+
+        from_mont(result, result, scratch);
+        return integer(result);
+    }
+
+    // r = t - N if the (n + 1)-limb value (high, t) is at least N, otherwise r = t. The
+    // subtraction always runs and the result is selected by mask, so the timing is independent
+    // of the values.
+    void final_subtract(limb_type* r, const limb_type* t, limb_type high) const noexcept
+    {
+        const limb_type borrow = ops::sub_n(r, t, modulus_limbs_.data(), size_);
+        const limb_type keep = 0 - (borrow & ~high & 1);
+        for (size_t i = 0; i < size_; ++i)
+            r[i] = (t[i] & keep) | (r[i] & ~keep);
+    }
+
+    void load(limb_type* dst, const integer_type& x) const noexcept
+    {
+        const auto limbs = x.limbs();
+        std::copy(limbs.begin(), limbs.end(), dst);
+        std::fill(dst + limbs.size(), dst + size_, limb_type(0));
+    }
+
+    [[nodiscard]] LimbStorage<InlineLimbs> padded(const integer_type& x) const
+    {
+        LimbStorage<InlineLimbs> limbs;
+        limbs.resize(size_);
+        load(limbs.data(), x);
+        return limbs;
+    }
+
+    [[nodiscard]] integer_type integer(const limb_type* limbs) const
+    {
+        return integer_type::from_limbs({limbs, size_});
+    }
+
+    integer_type modulus_;
+    LimbStorage<InlineLimbs> modulus_limbs_;
+    LimbStorage<InlineLimbs> one_;
+    LimbStorage<InlineLimbs> r_squared_;
+    limb_type neg_inverse_ = 0;
+    size_t size_ = 0;
+};
+
+// Lehmer's GCD. Euclid's quotients are computed on the leading two limbs of both operands and
+// accumulated into a 2x2 cofactor matrix with single-limb entries; the matrix is applied to the
+// full numbers only once per limb or so of progress, replacing a multi-limb division per step.
+// Above GcdThresholds::HALF_GCD limbs, the half-GCD of Schoenhage and Moeller first halves the
+// operands with matrices found recursively on their leading halves, in O(M(n) log n).
+template <size_t InlineLimbs>
+class GreatestCommonDivisor
+{
+    using ops = LimbArithmetic;
+
+public:
+    using limb_type = LimbArithmetic::limb_type;
+    using integer_type = BasicBigInteger<InlineLimbs>;
+
+    [[nodiscard]] static integer_type gcd(const integer_type& a, const integer_type& b)
+    {
+        const integer_type u = a.abs();
+        const integer_type v = b.abs();
+        return u < v ? reduce(v, u, nullptr) : reduce(u, v, nullptr);
+    }
+
+    // (g, x, y) with a * x + b * y = g = gcd(|a|, |b|).
+    [[nodiscard]] static std::tuple<integer_type, integer_type, integer_type>
+    extended_gcd(const integer_type& a, const integer_type& b)
+    {
+        const bool swapped = a.abs() < b.abs();
+        const integer_type& larger = swapped ? b : a;
+        const integer_type& smaller = swapped ? a : b;
+
+        // Only the coefficient of the smaller operand is tracked; the other follows exactly.
+        integer_type y;
+        integer_type g = reduce(larger.abs(), smaller.abs(), &y);
+        if (smaller.is_negative())
+            y.negate();
+
+        integer_type x = larger.is_zero() ? integer_type(1) : (g - smaller * y) / larger;
+        if (swapped)
+            return {std::move(g), std::move(y), std::move(x)};
+        return {std::move(g), std::move(x), std::move(y)};
+    }
+
+    // Inverse of a modulo m in [0, m), or 0 when gcd(a, m) != 1.
+    [[nodiscard]] static integer_type modular_inverse(const integer_type& a, const integer_type& m)
+    {
+        if (m.sign() <= 0)
+            throw std::domain_error("Modulus must be positive");
+
+        integer_type residue = a % m;
+        if (residue.is_negative())
+            residue += m;
+
+        integer_type cofactor;
+        if (reduce(m, residue, &cofactor) != integer_type(1) || m == integer_type(1))
+            return integer_type(0);
+        if (cofactor.is_negative())
+            cofactor += m;
+        return cofactor;
+    }
+
+private:
+    static constexpr int LIMB_BITS = LimbArithmetic::LIMB_BITS;
+
+    struct DoubleLimb
+    {
+        limb_type high = 0;
+        limb_type low = 0;
+
+        [[nodiscard]] bool is_zero() const noexcept { return (high | low) == 0; }
+
+        friend bool operator<(const DoubleLimb& a, const DoubleLimb& b) noexcept
+        {
+            return a.high != b.high ? a.high < b.high : a.low < b.low;
+        }
+    };
+
+    // Product of Euclid steps (u, v) -> (v, u - q * v). Entries are magnitudes: after an even
+    // number of steps u' = a * u - b * v and v' = d * v - c * u, after an odd one both signs flip.
+    template <typename Entry>
+    struct Matrix
+    {
+        Entry a = 1;
+        Entry b = 0;
+        Entry c = 0;
+        Entry d = 1;
+        bool odd = false;
+        size_t steps = 0;
+    };
+
+    using LimbMatrix = Matrix<limb_type>;
+    using IntegerMatrix = Matrix<integer_type>;
+
+    // Coefficient magnitudes of the initial v in the current u and v, as in the Lehmer loop.
+    struct Cofactors
+    {
+        integer_type u = 0;
+        integer_type v = 1;
+        bool odd = false;
+    };
+
+    // Runs Euclid on u >= v >= 0 and returns the gcd. With cofactor set, also returns y such
+    // that gcd = y * v (mod u) for the initial u and v. Large operands are halved repeatedly
+    // by the half-GCD until Lehmer's algorithm takes over.
+    static integer_type reduce(const integer_type& u0, const integer_type& v0,
+                               integer_type* cofactor)
+    {
+        if (u0.limb_count() < GcdThresholds::HALF_GCD)
+            return lehmer(u0, v0, Cofactors{}, u0.limb_count(), cofactor);
+
+        integer_type u = u0;
+        integer_type v = v0;
+        Cofactors x;
+        while (u.limb_count() >= GcdThresholds::HALF_GCD && !v.is_zero())
+        {
+            IntegerMatrix m = half_gcd(u, v, u.bit_length() / 2 + 1);
+            if (m.steps == 0)
+            {
+                // v is too short for the leading halves to share any quotient.
+                auto [q, r] = u.divrem(v);
+                u = std::exchange(v, std::move(r));
+                m = {0, 1, 1, std::move(q), true, 1};
+            }
+
+            if (cofactor)
+            {
+                integer_type next = m.a * x.u + m.b * x.v;
+                x.v = m.c * x.u + m.d * x.v;
+                x.u = std::move(next);
+            }
+            x.odd ^= m.odd;
+        }
+        return lehmer(u, v, x, u0.limb_count(), cofactor);
+    }
+
+    // Half-GCD: runs Euclid on u >= v while both stay at least 2^s and returns the product of
+    // the steps taken. When 2^(2s) >= 2u, every entry of that matrix is at most u / 2^s <=
+    // 2^(s-1), so it also reduces any x = 2^p u + x0, y = 2^p v + y0 with x0, y0 < 2^p to
+    // values of at least 2^(p+s-1); only the last quotient may be one too large, which a swap
+    // repairs. That makes the matrices found on leading parts valid for the full numbers.
+    static IntegerMatrix half_gcd(integer_type& u, integer_type& v, size_t s)
+    {
+        if (v.bit_length() <= s)
+            return {};
+        if (u.limb_count() < GcdThresholds::HALF_GCD)
+            return lehmer_half_gcd(u, v, s, 0);
+
+        // The part above 2^s takes u down to about 3/4 of its length, and plain steps make sure
+        // of that, so that the leading part of what remains, cut to land just above 2^s, is at
+        // most half as long again. Plain steps that stop short have run out of steps to take.
+        IntegerMatrix m;
+        const size_t three_quarters = s + (u.bit_length() - s) / 2 + 1;
+        reduce_leading(u, v, s, m);
+        append(m, lehmer_half_gcd(u, v, s, three_quarters));
+        if (u.bit_length() > three_quarters)
+            return m;
+        reduce_leading(u, v, 2 * s + 2 - u.bit_length(), m);
+        append(m, lehmer_half_gcd(u, v, s, 0));
+        return m;
+    }
+
+    // Applies the half-GCD of u / 2^p and v / 2^p to u and v and appends it to m. The recursion
+    // already reduced the leading parts, so the matrix only needs to see the low p bits.
+    static void reduce_leading(integer_type& u, integer_type& v, size_t p, IntegerMatrix& m)
+    {
+        integer_type high_u = u >> p;
+        integer_type high_v = v >> p;
+        IntegerMatrix step = half_gcd(high_u, high_v, high_u.bit_length() / 2 + 1);
+        if (step.steps == 0)
+            return;
+
+        const integer_type low_u = low_bits(u, p);
+        const integer_type low_v = low_bits(v, p);
+        integer_type x = step.a * low_u - step.b * low_v;
+        integer_type y = step.d * low_v - step.c * low_u;
+        if (step.odd)
+        {
+            x.negate();
+            y.negate();
+        }
+        u = (high_u <<= p) + x;
+        v = (high_v <<= p) + y;
+
+        // Only the last quotient can be one too large for the full numbers; a swap repairs it
+        // as an extra step with quotient zero.
+        if (u < v)
+        {
+            std::swap(u, v);
+            std::swap(step.a, step.c);
+            std::swap(step.b, step.d);
+            step.odd = !step.odd;
+            ++step.steps;
+        }
+        m = compose(step, m);
+    }
+
+    // x mod 2^p for x >= 0.
+    static integer_type low_bits(const integer_type& x, size_t p)
+    {
+        const auto limbs = x.limbs();
+        const size_t count = std::min(limbs.size(), p / LIMB_BITS);
+        integer_type low = integer_type::from_limbs(limbs.first(count));
+        if (count < limbs.size() && p % LIMB_BITS != 0)
+        {
+            const limb_type top = limbs[count] & ((limb_type(1) << (p % LIMB_BITS)) - 1);
+            low += integer_type(top) << (count * LIMB_BITS);
+        }
+        return low;
+    }
+
+    // Lehmer's loop for half_gcd(), stopping early once u has at most `stop` bits. Both columns
+    // of the matrix are accumulated like the cofactors in lehmer(); a batch of steps that would
+    // take v below 2^s is dropped in favour of single steps.
+    static IntegerMatrix lehmer_half_gcd(integer_type& u0, integer_type& v0, size_t s,
+                                         size_t stop)
+    {
+        const size_t n = u0.limb_count() + 2;
+        LimbStorage<InlineLimbs> buffer;
+        buffer.resize(12 * n);
+        limb_type* u = buffer.data();
+        limb_type* v = u + n;
+        limb_type* t = v + n;
+        limb_type* w = t + n;
+        limb_type* a = w + n;
+        limb_type* b = a + n;
+        limb_type* c = b + n;
+        limb_type* d = c + n;
+        limb_type* ta = d + n;
+        limb_type* tb = ta + n;
+        limb_type* tc = tb + n;
+        limb_type* td = tc + n;
+
+        std::copy(u0.limbs().begin(), u0.limbs().end(), u);
+        std::copy(v0.limbs().begin(), v0.limbs().end(), v);
+        size_t un = u0.limb_count();
+        size_t vn = v0.limb_count();
+        size_t mn = 1;
+        a[0] = 1;
+        d[0] = 1;
+        bool odd = false;
+        size_t steps = 0;
+
+        while (vn != 0 && bit_length(v, vn) > s && bit_length(u, un) > stop)
+        {
+            const LimbMatrix m = leading_matrix(u, un, v, vn);
+            if (m.steps != 0)
+            {
+                combine(m, t, w, u, v, un);
+                const size_t wn = normalized(w, un);
+                if (wn != 0 && bit_length(w, wn) > s)
+                {
+                    std::swap(u, t);
+                    std::swap(v, w);
+                    un = normalized(u, un);
+                    vn = wn;
+                    accumulate(m, ta, tc, a, c, mn);
+                    accumulate(m, tb, td, b, d, mn);
+                    std::swap(a, ta);
+                    std::swap(b, tb);
+                    std::swap(c, tc);
+                    std::swap(d, td);
+                    mn = std::max(normalized(c, mn + 2), normalized(d, mn + 2));
+                    odd ^= m.odd;
+                    steps += m.steps;
+                    continue;
+                }
+            }
+
+            const integer_type divisor = integer_type::from_limbs({v, vn});
+            const auto [q, r] = integer_type::from_limbs({u, un}).divrem(divisor);
+            if (r.bit_length() <= s)
+                break;
+            store(u, n, divisor);
+            store(v, n, r);
+            un = vn;
+            vn = r.limb_count();
+
+            // The rows (a, b) and (c, d) become (c, d) and (a + q * c, b + q * d).
+            const integer_type next_c = integer_type::from_limbs({a, mn}) +
+                                        q * integer_type::from_limbs({c, mn});
+            const integer_type next_d = integer_type::from_limbs({b, mn}) +
+                                        q * integer_type::from_limbs({d, mn});
+            std::swap(a, c);
+            std::swap(b, d);
+            store(c, n, next_c);
+            store(d, n, next_d);
+            mn = std::max<size_t>({next_c.limb_count(), next_d.limb_count(), 1});
+            odd = !odd;
+            ++steps;
+        }
+
+        u0 = integer_type::from_limbs({u, un});
+        v0 = integer_type::from_limbs({v, vn});
+        return {integer_type::from_limbs({a, mn}), integer_type::from_limbs({b, mn}),
+                integer_type::from_limbs({c, mn}), integer_type::from_limbs({d, mn}), odd, steps};
+    }
+
+    // The steps of first followed by those of second.
+    static IntegerMatrix compose(const IntegerMatrix& second, const IntegerMatrix& first)
+    {
+        return {second.a * first.a + second.b * first.c, second.a * first.b + second.b * first.d,
+                second.c * first.a + second.d * first.c, second.c * first.b + second.d * first.d,
+                second.odd != first.odd, second.steps + first.steps};
+    }
+
+    static void append(IntegerMatrix& m, const IntegerMatrix& step)
+    {
+        if (step.steps != 0)
+            m = compose(step, m);
+    }
+
+    // Lehmer's loop over u0 >= v0 >= 0, starting from the cofactors x0 and finishing reduce().
+    // The magnitudes of the coefficients of v in the current u and v are kept in (xu, xv);
+    // their signs alternate with every step. All values live in one buffer: remainders never
+    // outgrow u0, and cofactors never exceed the initial operand of `capacity` limbs, so two
+    // spare limbs cover the carries of a matrix product.
+    static integer_type lehmer(const integer_type& u0, const integer_type& v0, const Cofactors& x0,
+                               size_t capacity, integer_type* cofactor)
+    {
+        const size_t n = capacity + 2;
+        LimbStorage<InlineLimbs> buffer;
+        buffer.resize(8 * n);
+        limb_type* u = buffer.data();
+        limb_type* v = u + n;
+        limb_type* t = v + n;
+        limb_type* s = t + n;
+        limb_type* xu = s + n;
+        limb_type* xv = xu + n;
+        limb_type* xt = xv + n;
+        limb_type* xs = xt + n;
+
+        std::copy(u0.limbs().begin(), u0.limbs().end(), u);
+        std::copy(v0.limbs().begin(), v0.limbs().end(), v);
+        std::copy(x0.u.limbs().begin(), x0.u.limbs().end(), xu);
+        std::copy(x0.v.limbs().begin(), x0.v.limbs().end(), xv);
+        size_t un = u0.limb_count();
+        size_t vn = v0.limb_count();
+        size_t xn = std::max<size_t>({x0.u.limb_count(), x0.v.limb_count(), 1});
+        bool odd = x0.odd;
+
+        while (vn != 0)
+        {
+            const LimbMatrix m = leading_matrix(u, un, v, vn);
+            if (m.steps == 0)
+            {
+                divide(u, un, v, vn, cofactor ? xu : nullptr, xv, xn, n);
+                odd = !odd;
+                continue;
+            }
+
+            combine(m, t, s, u, v, un);
+            std::swap(u, t);
+            std::swap(v, s);
+            un = normalized(u, un);
+            vn = normalized(v, un);
+
+            if (cofactor)
+            {
+                accumulate(m, xt, xs, xu, xv, xn);
+                std::swap(xu, xt);
+                std::swap(xv, xs);
+                xn = normalized(xv, xn + 2);
+            }
+            odd ^= m.odd;
+        }
+
+        if (cofactor)
+        {
+            *cofactor = integer_type::from_limbs({xu, normalized(xu, xn)});
+            if (!odd)
+                cofactor->negate();
+        }
+        return integer_type::from_limbs({u, un});
+    }
+
+    // Euclid's steps on the leading limbs of u >= v, or none when they determine no quotient.
+    static LimbMatrix leading_matrix(const limb_type* u, size_t un, const limb_type* v,
+                                     size_t vn) noexcept
+    {
+        if (un <= 2)
+            return euclid_matrix(leading(u, un, 0), leading(v, vn, 0));
+
+        // Quotients of the leading limbs only carry over while both operands share them.
+        const size_t shift = bit_length(u, un) - 2 * LIMB_BITS;
+        if (bit_length(v, vn) > shift + LIMB_BITS)
+            return lehmer_matrix(leading(u, un, shift), leading(v, vn, shift));
+        return {};
+    }
+
+    // One full Euclid step (u, v) -> (v, u mod v) with (xu, xv) -> (xv, xu + q * xv), for when
+    // the quotient does not fit in a limb. Arrays stay zero-padded to capacity n.
+    static void divide(limb_type* u, size_t& un, limb_type* v, size_t& vn, limb_type* xu,
+                       limb_type* xv, size_t& xn, size_t n)
+    {
+        const integer_type divisor = integer_type::from_limbs({v, vn});
+        const auto [q, r] = integer_type::from_limbs({u, un}).divrem(divisor);
+        store(u, n, divisor);
+        store(v, n, r);
+        un = vn;
+        vn = r.limb_count();
+
+        if (xu)
+        {
+            const integer_type y = integer_type::from_limbs({xv, xn});
+            const integer_type next = integer_type::from_limbs({xu, xn}) + q * y;
+            store(xu, n, y);
+            store(xv, n, next);
+            xn = std::max<size_t>(next.limb_count(), 1);
+        }
+    }
+
+    static void store(limb_type* x, size_t n, const integer_type& value) noexcept
+    {
+        std::fill(x, x + n, limb_type(0));
+        std::copy(value.limbs().begin(), value.limbs().end(), x);
+    }
+
+    // (x, y) = the values m takes u and v of n limbs to.
+    static void combine(const LimbMatrix& m, limb_type* x, limb_type* y, const limb_type* u,
+                        const limb_type* v, size_t n) noexcept
+    {
+        if (m.odd)
+        {
+            combine(x, v, m.b, u, m.a, n);
+            combine(y, u, m.c, v, m.d, n);
+        }
+        else
+        {
+            combine(x, u, m.a, v, m.b, n);
+            combine(y, v, m.d, u, m.c, n);
+        }
+    }
+
+    // (xt, xs) = the cofactor magnitudes m takes xu and xv of n limbs to, n + 2 limbs each.
+    static void accumulate(const LimbMatrix& m, limb_type* xt, limb_type* xs, const limb_type* xu,
+                           const limb_type* xv, size_t n) noexcept
+    {
+        accumulate(xt, xu, m.a, xv, m.b, n);
+        accumulate(xs, xu, m.c, xv, m.d, n);
+    }
+
+    // r[0..n) = x * p - y * q, which the caller knows to be non-negative and below 2^(64n).
+    static void combine(limb_type* r, const limb_type* p, limb_type x, const limb_type* q,
+                        limb_type y, size_t n) noexcept
+    {
+        ops::mul_1(r, p, n, x);
+        ops::submul_1(r, q, n, y);
+    }
+
+    // r[0..n+2) = x * p + y * q.
+    static void accumulate(limb_type* r, const limb_type* p, limb_type x, const limb_type* q,
+                           limb_type y, size_t n) noexcept
+    {
+        const limb_type high = ops::mul_1(r, p, n, x);
+        r[n] = high + ops::addmul_1(r, q, n, y);
+        r[n + 1] = r[n] < high;
+    }
+
+    static size_t normalized(const limb_type* x, size_t n) noexcept
+    {
+        while (n > 0 && x[n - 1] == 0)
+            --n;
+        return n;
+    }
+
+    static size_t bit_length(const limb_type* x, size_t n) noexcept
+    {
+        return (n - 1) * LIMB_BITS + static_cast<size_t>(std::bit_width(x[n - 1]));
+    }
+
+    // Exact Euclid on operands of at most two limbs, batched the same way as Lehmer's steps.
+    static LimbMatrix euclid_matrix(DoubleLimb u, DoubleLimb v) noexcept
+    {
+        LimbMatrix m;
+        limb_type q;
+        DoubleLimb product;
+        while (!v.is_zero() && quotient(u, v, q) && push(m, q))
+        {
+            multiply(v, q, product);
+            u = std::exchange(v, subtract(u, product));
+        }
+        return m;
+    }
+
+    // Knuth's Algorithm L on the leading two limbs uh, vh of u and v at a common shift. A
+    // quotient is accepted only when both ends of the interval that brackets the true ratio of
+    // the full numbers, (uh + A) / (vh + C) and (uh + B) / (vh + D), give the same value, so
+    // every step in the matrix is an exact step of Euclid on u and v.
+    static LimbMatrix lehmer_matrix(DoubleLimb uh, DoubleLimb vh) noexcept
+    {
+        LimbMatrix m;
+        while (true)
+        {
+            DoubleLimb n1, d1, n2, d2;
+            const bool in_range = m.odd ? subtract(uh, m.a, n1) && add(vh, m.c, d1) &&
+                                              add(uh, m.b, n2) && subtract(vh, m.d, d2)
+                                        : add(uh, m.a, n1) && subtract(vh, m.c, d1) &&
+                                              subtract(uh, m.b, n2) && add(vh, m.d, d2);
+            if (!in_range || d1.high == 0 || d2.high == 0)
+                break;
+
+            limb_type q;
+            DoubleLimb product;
+            if (!quotient(n1, d1, q) || !multiply(d2, q, product) || n2 < product ||
+                !(subtract(n2, product) < d2))
+                break;
+
+            if (!multiply(vh, q, product) || uh < product || !push(m, q))
+                break;
+            uh = std::exchange(vh, subtract(uh, product));
+        }
+        return m;
+    }
+
+    // Appends the step with quotient q to m, unless an entry would outgrow a limb.
+    static bool push(LimbMatrix& m, limb_type q) noexcept
+    {
+        limb_type c_high, d_high;
+        const limb_type c_low = ops::mul_wide(q, m.c, c_high);
+        const limb_type d_low = ops::mul_wide(q, m.d, d_high);
+        const limb_type c = c_low + m.a;
+        const limb_type d = d_low + m.b;
+        if (c_high != 0 || d_high != 0 || c < c_low || d < d_low)
+            return false;
+
+        m.a = std::exchange(m.c, c);
+        m.b = std::exchange(m.d, d);
+        m.odd = !m.odd;
+        ++m.steps;
+        return true;
+    }
+
+    // floor(x / 2^shift) truncated to two limbs, for x of n limbs.
+    static DoubleLimb leading(const limb_type* x, size_t n, size_t shift) noexcept
+    {
+        const auto limb = [&](size_t i) { return i < n ? x[i] : limb_type(0); };
+        const size_t index = shift / LIMB_BITS;
+        const unsigned offset = shift % LIMB_BITS;
+        if (offset == 0)
+            return {limb(index + 1), limb(index)};
+        return {(limb(index + 1) >> offset) | (limb(index + 2) << (LIMB_BITS - offset)),
+                (limb(index) >> offset) | (limb(index + 1) << (LIMB_BITS - offset))};
+    }
+
+    static bool add(DoubleLimb a, limb_type b, DoubleLimb& r) noexcept
+    {
+        r.low = a.low + b;
+        r.high = a.high + (r.low < b);
+        return r.high >= a.high;
+    }
+
+    static bool subtract(DoubleLimb a, limb_type b, DoubleLimb& r) noexcept
+    {
+        r.low = a.low - b;
+        r.high = a.high - (a.low < b);
+        return r.high <= a.high;
+    }
+
+    // a - b for a >= b.
+    static DoubleLimb subtract(DoubleLimb a, DoubleLimb b) noexcept
+    {
+        return {a.high - b.high - (a.low < b.low), a.low - b.low};
+    }
+
+    static bool multiply(DoubleLimb a, limb_type q, DoubleLimb& r) noexcept
+    {
+        limb_type carry;
+        r.low = ops::mul_wide(a.low, q, carry);
+        limb_type overflow;
+        r.high = ops::mul_wide(a.high, q, overflow) + carry;
+        return overflow == 0 && r.high >= carry;
+    }
+
+    // floor(n / d) for d != 0, if it fits in a limb. Most Euclid quotients are 1 or 2, so those
+    // are found by subtraction. When d has at least 96 bits, n.high / d.high overestimates the
+    // quotient by at most two; otherwise the estimate from the leading limb of the normalized
+    // divisor does (Knuth, Theorem 4.3.1B).
+    static bool quotient(DoubleLimb n, DoubleLimb d, limb_type& q) noexcept
+    {
+        DoubleLimb r = n;
+        for (q = 0; q < 3; ++q)
+        {
+            if (r < d)
+                return true;
+            r = subtract(r, d);
+        }
+
+        DoubleLimb product;
+        if (d.high >> (LIMB_BITS / 2) != 0)
+        {
+            q = n.high / d.high;
+            while (!multiply(d, q, product) || n < product)
+                --q;
+            return true;
+        }
+
+        limb_type remainder;
+        if (d.high == 0)
+        {
+            if (n.high >= d.low)
+                return false;
+            q = ops::div_wide(n.high, n.low, d.low, remainder);
+            return true;
+        }
+
+        const int shift = std::countl_zero(d.high);
+        limb_type top = d.high;
+        limb_type n2 = 0;
+        limb_type n1 = n.high;
+        if (shift != 0)
+        {
+            top = (d.high << shift) | (d.low >> (LIMB_BITS - shift));
+            n2 = n.high >> (LIMB_BITS - shift);
+            n1 = (n.high << shift) | (n.low >> (LIMB_BITS - shift));
+        }
+        q = n2 >= top ? ~limb_type(0) : ops::div_wide(n2, n1, top, remainder);
+        while (!multiply(d, q, product) || n < product)
+            --q;
+        return true;
+    }
+};
+
+// Baillie-PSW probable-prime test: trial division by the odd primes below 256, one strong
+// Fermat test to base 2 and one strong Lucas test with Selfridge's parameters, both in Montgomery
+// form. No composite is known to pass both, and none exists below 2^64; single-limb inputs take
+// the deterministic Miller-Rabin path instead.
+template <size_t InlineLimbs>
+class PrimalityTest
+{
+    using ops = LimbArithmetic;
+
+public:
+    using limb_type = LimbArithmetic::limb_type;
+    using integer_type = BasicBigInteger<InlineLimbs>;
+    using context_type = MontgomeryContext<InlineLimbs>;
+
+    [[nodiscard]] static bool is_probable_prime(const integer_type& n)
+    {
+        if (n.sign() <= 0)
+            return false;
+        if (n.limb_count() == 1)
+            return ArithmeticOperations::is_prime_miller_rabin(n.limbs()[0]);
+        if (n.is_even() || has_small_factor(n))
+            return false;
+
+        const context_type context(n);
+        if (!strong_probable_prime_base_2(context))
+            return false;
+
+        // Selfridge's method A: the first D in 5, -7, 9, -11, ... with (D / n) = -1. No such D
+        // exists for a square, so squares are ruled out once a few candidates have failed.
+        int64_t d = 5;
+        for (int attempt = 0;; ++attempt)
+        {
+            if (attempt == 8 && is_square(n))
+                return false;
+
+            const int symbol = small_jacobi(d, n);
+            if (symbol == -1)
+                break;
+            if (symbol == 0)
+                return false;
+            d = d > 0 ? -(d + 2) : 2 - d;
+        }
+
+        return strong_lucas_probable_prime(context, d);
+    }
+
+    // Jacobi symbol (a / n) for positive odd n. Runs the binary algorithm on BigIntegers until
+    // the modulus fits one limb.
+    [[nodiscard]] static int jacobi(const integer_type& a, const integer_type& n)
+    {
+        if (n.sign() <= 0 || n.is_even())
+            throw std::domain_error("Jacobi symbol needs a positive odd modulus");
+
+        integer_type m = n;
+        integer_type x = a % m;
+        if (x.is_negative())
+            x += m;
+
+        int result = 1;
+        while (m.limb_count() > 1)
+        {
+            if (x.is_zero())
+                return 0;
+
+            const size_t zeros = trailing_zeros(x);
+            x >>= zeros;
+            const limb_type low = m.limbs()[0];
+            if ((zeros & 1) && ((low & 7) == 3 || (low & 7) == 5))
+                result = -result;
+            if ((x.limbs()[0] & 3) == 3 && (low & 3) == 3)
+                result = -result;
+            std::swap(x, m);
+            x %= m;
+        }
+
+        const limb_type residue = x.is_zero() ? 0 : x.limbs()[0];
+        return result * ArithmeticOperations::jacobi_symbol(residue, m.limbs()[0]);
+    }
+
+private:
+    // The odd primes below 256.
+    static constexpr size_t TRIAL_PRIMES = 53;
+
+    // n mod d for a single-limb d, reading the limbs of |n| once.
+    static limb_type remainder(const integer_type& n, limb_type d) noexcept
+    {
+        limb_type r = 0;
+        const auto limbs = n.limbs();
+        for (size_t i = limbs.size(); i-- > 0;)
+            ops::div_wide(r, limbs[i], d, r);
+        return r;
+    }
+
+    // The primes are packed into products below 2^64, so each group costs one pass over n and
+    // the individual tests run on a single-limb remainder.
+    static bool has_small_factor(const integer_type& n) noexcept
+    {
+        const auto& primes = SmallPrimes::ODD;
+        for (size_t first = 0; first < TRIAL_PRIMES;)
+        {
+            limb_type product = 1;
+            size_t last = first;
+            while (last < TRIAL_PRIMES && product <= ~limb_type(0) / primes[last])
+                product *= primes[last++];
+
+            const limb_type r = remainder(n, product);
+            for (size_t i = first; i < last; ++i)
+            {
+                if (r % primes[i] == 0)
+                    return true;
+            }
+            first = last;
+        }
+        return false;
+    }
+
+    static size_t trailing_zeros(const integer_type& x) noexcept
+    {
+        const auto limbs = x.limbs();
+        size_t i = 0;
+        while (limbs[i] == 0)
+            ++i;
+        return i * LimbArithmetic::LIMB_BITS + static_cast<size_t>(std::countr_zero(limbs[i]));
+    }
+
+    // (d / n) for a small odd d through reciprocity, so only one pass over n is needed.
+    static int small_jacobi(int64_t d, const integer_type& n)
+    {
+        const auto m = static_cast<limb_type>(d < 0 ? -d : d);
+        int symbol = ArithmeticOperations::jacobi_symbol(remainder(n, m), m);
+        const limb_type low = n.limbs()[0];
+        if (d < 0 && (low & 3) == 3)
+            symbol = -symbol;
+        if ((m & 3) == 3 && (low & 3) == 3)
+            symbol = -symbol;
+        return symbol;
+    }
+
+    static bool is_square(const integer_type& n)
+    {
+        // Newton's iteration from above converges to floor(sqrt(n)).
+        integer_type x = integer_type(1) << ((n.bit_length() + 1) / 2);
+        while (true)
+        {
+            integer_type y = (x + n / x) >> 1;
+            if (y >= x)
+                break;
+            x = std::move(y);
+        }
+        return x.square() == n;
+    }
+
+    // With n - 1 = d * 2^s, n passes when 2^d = 1 or 2^(d 2^r) = -1 for some r < s.
+    static bool strong_probable_prime_base_2(const context_type& context)
+    {
+        const integer_type& n = context.modulus();
+        const integer_type n_minus_1 = n - 1;
+        const size_t s = trailing_zeros(n_minus_1);
+
+        const integer_type one = context.one();
+        const integer_type minus_one = n - one;
+        integer_type x = context.to_mont(context.pow(integer_type(2), n_minus_1 >> s));
+        if (x == one || x == minus_one)
+            return true;
+
+        for (size_t r = 1; r < s; ++r)
+        {
+            x = context.sqr(x);
+            if (x == minus_one)
+                return true;
+            if (x == one)
+                return false;
+        }
+        return false;
+    }
+
+    // Lucas sequences with P = 1 and Q = (1 - D) / 4. With n + 1 = k * 2^s, n passes when
+    // U_k = 0 or V_(k 2^r) = 0 mod n for some r < s. U_k, V_k and Q^k are carried through
+    // the bits of k with the doubling formulas U_2k = U_k V_k, V_2k = V_k^2 - 2 Q^k and the
+    // increments U_(k+1) = (U_k + V_k) / 2, V_(k+1) = (D U_k + V_k) / 2.
+    static bool strong_lucas_probable_prime(const context_type& context, int64_t d)
+    {
+        const integer_type& n = context.modulus();
+        const integer_type n_plus_1 = n + 1;
+        const size_t s = trailing_zeros(n_plus_1);
+        const integer_type k = n_plus_1 >> s;
+        const size_t size = context.size();
+
+        LimbStorage<InlineLimbs> buffer;
+        buffer.resize(6 * size + context.scratch_size());
+        limb_type* u = buffer.data();
+        limb_type* v = u + size;
+        limb_type* q_power = v + size;
+        limb_type* d_mont = q_power + size;
+        limb_type* q_mont = d_mont + size;
+        limb_type* t = q_mont + size;
+        limb_type* scratch = t + size;
+
+        const auto store = [size](limb_type* dst, const integer_type& x) {
+            const auto limbs = x.limbs();
+            std::copy(limbs.begin(), limbs.end(), dst);
+            std::fill(dst + limbs.size(), dst + size, limb_type(0));
+        };
+        store(d_mont, context.to_mont(integer_type(d)));
+        store(q_mont, context.to_mont(integer_type((1 - d) / 4)));
+        store(u, context.one());
+        store(v, context.one());
+        std::copy(q_mont, q_mont + size, q_power);
+
+        const auto double_v = [&] {
+            context.sqr(v, v, scratch);
+            context.add(t, q_power, q_power, scratch);
+            context.sub(v, v, t);
+            context.sqr(q_power, q_power, scratch);
+        };
+
+        for (size_t bit = k.bit_length() - 1; bit-- > 0;)
+        {
+            context.mul(u, u, v, scratch);
+            double_v();
+            if (k.test_bit(bit))
+            {
+                context.mul(t, d_mont, u, scratch);
+                context.add(u, u, v, scratch);
+                context.half(u, u);
+                context.add(v, v, t, scratch);
+                context.half(v, v);
+                context.mul(q_power, q_power, q_mont, scratch);
+            }
+        }
+
+        const auto is_zero = [size](const limb_type* x) {
+            return std::all_of(x, x + size, [](limb_type limb) { return limb == 0; });
+        };
+        if (is_zero(u) || is_zero(v))
+            return true;
+
+        for (size_t r = 1; r < s; ++r)
+        {
+            double_v();
+            if (is_zero(v))
+                return true;
+        }
+        return false;
+    }
+};
+
+} // namespace detail
+
+#ifndef BIGINTEGER_DEFAULT_INLINE_LIMBS
+#define BIGINTEGER_DEFAULT_INLINE_LIMBS 4
+#endif
+
+// Signed arbitrary precision integer. The magnitude is stored as little-endian 64-bit limbs, the
+// first InlineLimbs of which live inside the object so that small values never touch the heap.
+template <size_t InlineLimbs>
+class BasicBigInteger
+{
+    using limb_ops = detail::LimbArithmetic;
+
+public:
+    using limb_type = detail::LimbArithmetic::limb_type;
+    using storage_type = detail::LimbStorage<InlineLimbs>;
+    static constexpr size_t inline_limbs = InlineLimbs;
+    static constexpr int LIMB_BITS = detail::LimbArithmetic::LIMB_BITS;
+
+    BasicBigInteger() noexcept = default;
+
+    template <std::integral T>
+    BasicBigInteger(T value)
+    {
+        if constexpr (std::is_signed_v<T>)
+        {
+            negative_ = value < 0;
+            const auto magnitude = static_cast<uint64_t>(static_cast<int64_t>(value));
+            assign_magnitude(negative_ ? 0 - magnitude : magnitude);
+        }
+        else
+        {
+            assign_magnitude(static_cast<uint64_t>(value));
+        }
+    }
+
+    explicit BasicBigInteger(std::string_view str, int base = 10)
+    {
+        *this = from_string(str, base);
+    }
+
+    static BasicBigInteger from_limbs(std::span<const limb_type> limbs, bool negative = false)
+    {
+        BasicBigInteger result;
+        result.limbs_.assign(limbs.begin(), limbs.end());
+        result.negative_ = negative;
+        result.normalize();
+        return result;
+    }
+
+    static BasicBigInteger from_string(std::string_view str, int base = 10)
+    {
+        if (base < 2 || base > 36)
+            throw std::out_of_range("Base must be between 2 and 36");
+
+        bool negative = false;
+        if (!str.empty() && (str[0] == '-' || str[0] == '+'))
+        {
+            negative = str[0] == '-';
+            str.remove_prefix(1);
+        }
+
+        if ((base == 16 && (str.starts_with("0x") || str.starts_with("0X"))) ||
+            (base == 2 && (str.starts_with("0b") || str.starts_with("0B"))))
+        {
+            str.remove_prefix(2);
+        }
+
+        if (str.empty())
+            throw std::invalid_argument("Empty digit sequence");
+
+        if (!std::all_of(str.begin(), str.end(), [base](char c) {
+                return detail::RadixConversion::digit_value(c) < static_cast<limb_type>(base);
+            }))
+            throw std::invalid_argument("Invalid digit for base");
+
+        BasicBigInteger result;
+        result.assign_digits(str, static_cast<limb_type>(base));
+        result.negative_ = negative && !result.is_zero();
+        return result;
+    }
+
+    // Upper bound on the characters to_chars() writes for this value, sign included.
+    [[nodiscard]] size_t max_chars(int base = 10) const noexcept
+    {
+        return (negative_ ? 1 : 0) + detail::RadixConversion::max_chars(limbs_, base);
+    }
+
+    // Small values peel one limb-sized chunk of digits per pass. Larger ones split at
+    // chunk_base^(2^k) with the fast division and convert both halves recursively, which runs in
+    // O(M(n) log n). from_string() mirrors this, joining halves with the fast multiplication.
+    // Power-of-two bases read digits straight from the bits at any size.
+    [[nodiscard]] std::string to_string(int base = 10) const
+    {
+        if (base < 2 || base > 36)
+            throw std::out_of_range("Base must be between 2 and 36");
+
+        if (is_zero())
+            return "0";
+
+        const auto radix = static_cast<limb_type>(base);
+        std::string result;
+        if (negative_)
+            result += '-';
+
+        if (limbs_.size() < detail::ConversionThresholds::TO_STRING || std::has_single_bit(radix))
+        {
+            append_digits(result, limbs_.data(), limbs_.size(), radix, 0);
+            return result;
+        }
+
+        // powers[k] = chunk_base^(2^k), up to the first whose square surely exceeds the value.
+        std::vector<BasicBigInteger> powers{
+            BasicBigInteger(detail::RadixConversion::chunk_for_base(radix).first)};
+        while (2 * powers.back().limbs_.size() - 1 <= limbs_.size())
+            powers.push_back(powers.back().square());
+
+        append_digits(result, abs(), powers, powers.size(), radix, 0);
+        return result;
+    }
+
+    [[nodiscard]] bool is_zero() const noexcept { return limbs_.empty(); }
+
+    [[nodiscard]] bool is_negative() const noexcept { return negative_; }
+
+    [[nodiscard]] bool is_odd() const noexcept { return !limbs_.empty() && (limbs_[0] & 1); }
+
+    [[nodiscard]] bool is_even() const noexcept { return !is_odd(); }
+
+    [[nodiscard]] int sign() const noexcept { return is_zero() ? 0 : (negative_ ? -1 : 1); }
+
+    [[nodiscard]] size_t limb_count() const noexcept { return limbs_.size(); }
+
+    [[nodiscard]] std::span<const limb_type> limbs() const noexcept { return limbs_; }
+
+    [[nodiscard]] size_t bit_length() const noexcept
+    {
+        if (limbs_.empty())
+            return 0;
+        return limbs_.size() * LIMB_BITS -
+               static_cast<size_t>(detail::BitManipulation::count_leading_zeros(limbs_.back()));
+    }
+
+    [[nodiscard]] bool test_bit(size_t index) const noexcept
+    {
+        const size_t limb = index / LIMB_BITS;
+        return limb < limbs_.size() && ((limbs_[limb] >> (index % LIMB_BITS)) & 1);
+    }
+
+    [[nodiscard]] BasicBigInteger abs() const
+    {
+        BasicBigInteger result = *this;
+        result.negative_ = false;
+        return result;
+    }
+
+    [[nodiscard]] BasicBigInteger square() const
+    {
+        BasicBigInteger result;
+        if (is_zero())
+            return result;
+
+        result.limbs_.resize_for_overwrite(2 * limbs_.size());
+        detail::Multiplication::square(result.limbs_.data(), limbs_.data(), limbs_.size());
+        result.normalize();
+        return result;
+    }
+
+    // Quotient and remainder of one division, truncated toward zero like operator/ and
+    // operator%.
+    [[nodiscard]] std::pair<BasicBigInteger, BasicBigInteger>
+    divrem(const BasicBigInteger& divisor) const
+    {
+        std::pair<BasicBigInteger, BasicBigInteger> result;
+        divide(*this, divisor, &result.first, &result.second);
+        return result;
+    }
+
+    // Left-to-right binary exponentiation; every doubling step goes through square().
+    [[nodiscard]] BasicBigInteger pow(uint64_t exponent) const
+    {
+        BasicBigInteger result(1);
+        for (int bit = std::bit_width(exponent) - 1; bit >= 0; --bit)
+        {
+            result = result.square();
+            if ((exponent >> bit) & 1)
+                result *= *this;
+        }
+        return result;
+    }
+
+    explicit operator bool() const noexcept { return !is_zero(); }
+
+    // Truncates to the low bits of the two's complement representation, like a static_cast
+    // between native integers.
+    template <std::integral T>
+        requires(!std::same_as<T, bool>)
+    explicit operator T() const noexcept
+    {
+        const uint64_t low = limbs_.empty() ? 0 : limbs_[0];
+        return static_cast<T>(negative_ ? 0 - low : low);
+    }
+
+    BasicBigInteger operator+() const { return *this; }
+
+    BasicBigInteger operator-() const
+    {
+        BasicBigInteger result = *this;
+        result.negate();
+        return result;
+    }
+
+    void negate() noexcept
+    {
+        if (!is_zero())
+            negative_ = !negative_;
+    }
+
+    BasicBigInteger& operator+=(const BasicBigInteger& rhs)
+    {
+        add_signed(rhs, rhs.negative_);
+        return *this;
+    }
+
+    BasicBigInteger& operator-=(const BasicBigInteger& rhs)
+    {
+        add_signed(rhs, !rhs.negative_);
+        return *this;
+    }
+
+    BasicBigInteger& operator*=(const BasicBigInteger& rhs)
+    {
+        if (is_zero() || rhs.is_zero())
+        {
+            limbs_.clear();
+            negative_ = false;
+            return *this;
+        }
+
+        storage_type product;
+        product.resize_for_overwrite(limbs_.size() + rhs.limbs_.size());
+        detail::Multiplication::multiply(product.data(), limbs_.data(), limbs_.size(),
+                                         rhs.limbs_.data(), rhs.limbs_.size());
+
+        limbs_ = std::move(product);
+        negative_ = negative_ != rhs.negative_;
+        normalize();
+        return *this;
+    }
+
+    BasicBigInteger& operator/=(const BasicBigInteger& rhs)
+    {
+        BasicBigInteger remainder;
+        divide(*this, rhs, this, &remainder);
+        return *this;
+    }
+
+    BasicBigInteger& operator%=(const BasicBigInteger& rhs)
+    {
+        BasicBigInteger quotient;
+        divide(*this, rhs, &quotient, this);
+        return *this;
+    }
+
+    BasicBigInteger& operator<<=(size_t count)
+    {
+        if (is_zero() || count == 0)
+            return *this;
+
+        const size_t limb_shift = count / LIMB_BITS;
+        const unsigned bit_shift = static_cast<unsigned>(count % LIMB_BITS);
+        const size_t n = limbs_.size();
+
+        limbs_.resize(n + limb_shift + 1);
+        limb_type* data = limbs_.data();
+
+        if (bit_shift != 0)
+            data[n + limb_shift] = limb_ops::lshift(data + limb_shift, data, n, bit_shift);
+        else
+            std::copy_backward(data, data + n, data + n + limb_shift);
+
+        std::fill(data, data + limb_shift, limb_type(0));
+        normalize();
+        return *this;
+    }
+
+    // Arithmetic shift: negative values round toward negative infinity, matching the behaviour
+    // of >> on two's complement native integers.
+    BasicBigInteger& operator>>=(size_t count)
+    {
+        if (is_zero() || count == 0)
+            return *this;
+
+        const size_t limb_shift = count / LIMB_BITS;
+        const unsigned bit_shift = static_cast<unsigned>(count % LIMB_BITS);
+
+        if (limb_shift >= limbs_.size())
+        {
+            const bool round_down = negative_;
+            limbs_.clear();
+            negative_ = false;
+            if (round_down)
+                *this = BasicBigInteger(-1);
+            return *this;
+        }
+
+        bool lost_bits = false;
+        if (negative_)
+        {
+            lost_bits = std::any_of(limbs_.begin(), limbs_.begin() + limb_shift,
+                                    [](limb_type limb) { return limb != 0; });
+        }
+
+        const size_t n = limbs_.size() - limb_shift;
+        limb_type* data = limbs_.data();
+
+        if (bit_shift != 0)
+            lost_bits |= limb_ops::rshift(data, data + limb_shift, n, bit_shift) != 0;
+        else
+            std::copy(data + limb_shift, data + limb_shift + n, data);
+
+        limbs_.resize(n);
+
+        if (negative_ && lost_bits)
+        {
+            limbs_.push_back(0);
+            limb_ops::add_1(limbs_.data(), limbs_.data(), limbs_.size(), 1);
+        }
+
+        normalize();
+        return *this;
+    }
+
+    BasicBigInteger& operator++() { return *this += BasicBigInteger(1); }
+
+    BasicBigInteger& operator--() { return *this -= BasicBigInteger(1); }
+
+    BasicBigInteger operator++(int)
+    {
+        BasicBigInteger previous = *this;
+        ++*this;
+        return previous;
+    }
+
+    BasicBigInteger operator--(int)
+    {
+        BasicBigInteger previous = *this;
+        --*this;
+        return previous;
+    }
+
+    friend BasicBigInteger operator+(BasicBigInteger lhs, const BasicBigInteger& rhs)
+    {
+        return lhs += rhs;
+    }
+
+    friend BasicBigInteger operator-(BasicBigInteger lhs, const BasicBigInteger& rhs)
+    {
+        return lhs -= rhs;
+    }
+
+    friend BasicBigInteger operator*(BasicBigInteger lhs, const BasicBigInteger& rhs)
+    {
+        return lhs *= rhs;
+    }
+
+    friend BasicBigInteger operator/(const BasicBigInteger& lhs, const BasicBigInteger& rhs)
+    {
+        BasicBigInteger quotient, remainder;
+        divide(lhs, rhs, &quotient, &remainder);
+        return quotient;
+    }
+
+    friend BasicBigInteger operator%(const BasicBigInteger& lhs, const BasicBigInteger& rhs)
+    {
+        BasicBigInteger quotient, remainder;
+        divide(lhs, rhs, &quotient, &remainder);
+        return remainder;
+    }
+
+    friend BasicBigInteger operator<<(BasicBigInteger lhs, size_t count) { return lhs <<= count; }
+
+    friend BasicBigInteger operator>>(BasicBigInteger lhs, size_t count) { return lhs >>= count; }
+
+    friend bool operator==(const BasicBigInteger& lhs, const BasicBigInteger& rhs) noexcept
+    {
+        return lhs.negative_ == rhs.negative_ && lhs.limbs_ == rhs.limbs_;
+    }
+
+    friend std::strong_ordering operator<=>(const BasicBigInteger& lhs,
+                                            const BasicBigInteger& rhs) noexcept
+    {
+        if (lhs.negative_ != rhs.negative_)
+            return lhs.negative_ ? std::strong_ordering::less : std::strong_ordering::greater;
+
+        const int cmp = compare_magnitude(lhs, rhs);
+        const int signed_cmp = lhs.negative_ ? -cmp : cmp;
+        return signed_cmp < 0    ? std::strong_ordering::less
+               : signed_cmp > 0 ? std::strong_ordering::greater
+                                : std::strong_ordering::equal;
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, const BasicBigInteger& value)
+    {
+        return os << value.to_string();
+    }
+
+    // std::to_chars counterpart of to_string(): a '-' for negative values, then the digits.
+    // Values of fewer than ConversionThresholds::TO_STRING limbs, and all values in power-of-two
+    // bases, are written without allocating; larger ones go through to_string(). On
+    // value_too_large the range is left unspecified.
+    friend std::to_chars_result to_chars(char* first, char* last, const BasicBigInteger& value,
+                                         int base = 10)
+    {
+        if (value.limbs_.size() >= detail::ConversionThresholds::TO_STRING && base >= 2 &&
+            base <= 36 && !std::has_single_bit(static_cast<unsigned>(base)))
+        {
+            const std::string text = value.to_string(base);
+            if (text.size() > static_cast<size_t>(last - first))
+                return {last, std::errc::value_too_large};
+            return {std::copy(text.begin(), text.end(), first), std::errc{}};
+        }
+
+        if (value.negative_)
+        {
+            if (first == last)
+                return {last, std::errc::value_too_large};
+            *first++ = '-';
+        }
+        return detail::RadixConversion::to_chars(first, last, value.limbs_, base);
+    }
+
+    // std::from_chars counterpart of from_string(): an optional '-', then the longest run of
+    // digits valid in base, without a base prefix. Inputs of fewer digits than
+    // ConversionThresholds::FROM_STRING limbs hold are parsed into the storage value already
+    // has. On invalid_argument value is left unchanged.
+    friend std::from_chars_result from_chars(const char* first, const char* last,
+                                             BasicBigInteger& value, int base = 10)
+    {
+        const char* digits = first != last && *first == '-' ? first + 1 : first;
+        if (base < 2 || base > 36 || digits == last ||
+            detail::RadixConversion::digit_value(*digits) >= static_cast<limb_type>(base))
+            return {first, std::errc::invalid_argument};
+
+        const char* end = std::find_if_not(digits, last, [base](char c) {
+            return detail::RadixConversion::digit_value(c) < static_cast<limb_type>(base);
+        });
+        value.assign_digits(std::string_view(digits, static_cast<size_t>(end - digits)),
+                            static_cast<limb_type>(base));
+        value.negative_ = digits != first && !value.is_zero();
+        return {end, std::errc{}};
+    }
+
+private:
+    storage_type limbs_;
+    bool negative_ = false;
+
+    void normalize() noexcept
+    {
+        limbs_.resize(limb_ops::normalized_size(limbs_.data(), limbs_.size()));
+        if (limbs_.empty())
+            negative_ = false;
+    }
+
+    void assign_magnitude(uint64_t magnitude)
+    {
+        limbs_.clear();
+        if (magnitude != 0)
+            limbs_.push_back(magnitude);
+        else
+            negative_ = false;
+    }
+
+    // Appends the digits of the magnitude limbs[0..n), zero-padded to width unless width is 0.
+    static void append_digits(std::string& out, const limb_type* limbs, size_t n,
+                              limb_type radix, size_t width)
+    {
+        const std::span<const limb_type> magnitude(limbs, n);
+        const auto base = static_cast<int>(radix);
+        const size_t start = out.size();
+        out.resize(start + std::max(width, detail::RadixConversion::max_chars(magnitude, base)));
+
+        char* first = out.data() + start;
+        const size_t digits = static_cast<size_t>(
+            detail::RadixConversion::to_chars(first, out.data() + out.size(), magnitude, base).ptr -
+            first);
+        if (digits < width)
+        {
+            std::copy_backward(first, first + digits, first + width);
+            std::fill_n(first, width - digits, '0');
+        }
+        out.resize(start + std::max(width, digits));
+    }
+
+    // Appends value < powers[levels - 1]^2 by splitting it at powers[levels - 1].
+    static void append_digits(std::string& out, const BasicBigInteger& value,
+                              const std::vector<BasicBigInteger>& powers, size_t levels,
+                              limb_type radix, size_t width)
+    {
+        if (levels == 0 || value.limbs_.size() < detail::ConversionThresholds::TO_STRING)
+        {
+            append_digits(out, value.limbs_.data(), value.limbs_.size(), radix, width);
+            return;
+        }
+
+        BasicBigInteger high;
+        BasicBigInteger low;
+        divide(value, powers[levels - 1], &high, &low);
+
+        const size_t low_width = detail::RadixConversion::chunk_for_base(radix).second
+                                 << (levels - 1);
+        if (!high.is_zero() || width != 0)
+            append_digits(out, high, powers, levels - 1, radix, width ? width - low_width : 0);
+        append_digits(out, low, powers, levels - 1, radix,
+                      high.is_zero() && width == 0 ? 0 : low_width);
+    }
+
+    // Converts the high and low halves separately and joins them as high * powers[levels - 1] +
+    // low, where the low half holds chunk_digits * 2^(levels - 1) digits.
+    static BasicBigInteger parse_digits(std::string_view digits,
+                                        const std::vector<BasicBigInteger>& powers, size_t levels,
+                                        limb_type radix)
+    {
+        const size_t chunk_digits = detail::RadixConversion::chunk_for_base(radix).second;
+        if (levels == 0 || digits.size() < chunk_digits * detail::ConversionThresholds::FROM_STRING)
+        {
+            BasicBigInteger result;
+            result.assign_digits(digits, radix);
+            return result;
+        }
+
+        const size_t low_digits = chunk_digits << (levels - 1);
+        if (digits.size() <= low_digits)
+            return parse_digits(digits, powers, levels - 1, radix);
+
+        const size_t high_digits = digits.size() - low_digits;
+        BasicBigInteger result =
+            parse_digits(digits.substr(0, high_digits), powers, levels - 1, radix);
+        result *= powers[levels - 1];
+        result += parse_digits(digits.substr(high_digits), powers, levels - 1, radix);
+        return result;
+    }
+
+    // Sets the magnitude to the validated digit string. Short strings, and any in a power-of-two
+    // base, are read straight into the current storage; longer ones split at chunk_base^(2^k)
+    // from the right and join both halves with the fast multiplication, mirroring to_string().
+    void assign_digits(std::string_view digits, limb_type radix)
+    {
+        const auto [chunk_base, chunk_digits] = detail::RadixConversion::chunk_for_base(radix);
+        if (digits.size() >= chunk_digits * detail::ConversionThresholds::FROM_STRING &&
+            !std::has_single_bit(radix))
+        {
+            // powers[k] = chunk_base^(2^k), up to the first covering at least half the digits.
+            std::vector<BasicBigInteger> powers{BasicBigInteger(chunk_base)};
+            while ((chunk_digits << powers.size()) < digits.size())
+                powers.push_back(powers.back().square());
+
+            limbs_ = parse_digits(digits, powers, powers.size(), radix).limbs_;
+            return;
+        }
+
+        // A digit carries less than bit_width(chunk_base) / chunk_digits bits.
+        const auto chunk_bits = static_cast<size_t>(std::bit_width(chunk_base));
+        limbs_.resize_for_overwrite(digits.size() * chunk_bits / (chunk_digits * LIMB_BITS) + 1);
+        detail::RadixConversion::from_chars(digits.data(), digits.data() + digits.size(),
+                                            std::span(limbs_.data(), limbs_.size()),
+                                            static_cast<int>(radix));
+        limbs_.resize(limb_ops::normalized_size(limbs_.data(), limbs_.size()));
+    }
+
+    static int compare_magnitude(const BasicBigInteger& lhs, const BasicBigInteger& rhs) noexcept
+    {
+        return limb_ops::compare(lhs.limbs_.data(), lhs.limbs_.size(), rhs.limbs_.data(),
+                                 rhs.limbs_.size());
+    }
+
+    void add_signed(const BasicBigInteger& rhs, bool rhs_negative)
+    {
+        const size_t an = limbs_.size();
+        const size_t bn = rhs.limbs_.size();
+
+        if (bn == 0)
+            return;
+
+        if (negative_ == rhs_negative || an == 0)
+        {
+            limbs_.resize(std::max(an, bn) + 1);
+            limb_type* r = limbs_.data();
+            const limb_type* b = rhs.limbs_.data();
+
+            if (an >= bn)
+                r[an] = limb_ops::add(r, r, an, b, bn);
+            else
+            {
+                const limb_type carry = limb_ops::add_n(r, r, b, an);
+                r[bn] = limb_ops::add_1(r + an, b + an, bn - an, carry);
+            }
+
+            negative_ = rhs_negative;
+        }
+        else if (compare_magnitude(*this, rhs) >= 0)
+        {
+            limb_ops::sub(limbs_.data(), limbs_.data(), an, rhs.limbs_.data(), bn);
+        }
+        else
+        {
+            limbs_.resize(bn);
+            limb_type* r = limbs_.data();
+            const limb_type* b = rhs.limbs_.data();
+
+            const limb_type borrow = limb_ops::sub_n(r, b, r, an);
+            limb_ops::sub_1(r + an, b + an, bn - an, borrow);
+            negative_ = rhs_negative;
+        }
+
+        normalize();
+    }
+
+    // Truncating division: the quotient rounds toward zero and the remainder takes the sign of
+    // the dividend, as with the built-in operators.
+    static void divide(const BasicBigInteger& dividend, const BasicBigInteger& divisor,
+                       BasicBigInteger* quotient, BasicBigInteger* remainder)
+    {
+        if (divisor.is_zero())
+            throw std::domain_error("Division by zero");
+
+        const bool quotient_negative = dividend.negative_ != divisor.negative_;
+        const bool remainder_negative = dividend.negative_;
+        const size_t an = dividend.limbs_.size();
+        const size_t bn = divisor.limbs_.size();
+
+        if (compare_magnitude(dividend, divisor) < 0)
+        {
+            *remainder = dividend;
+            quotient->limbs_.clear();
+            quotient->negative_ = false;
+            return;
+        }
+
+        storage_type q;
+        storage_type r;
+        q.resize(an - bn + 1);
+        r.resize(bn);
+
+        if (bn == 1)
+            r[0] = limb_ops::divrem_1(q.data(), dividend.limbs_.data(), an, divisor.limbs_[0]);
+        else
+            detail::Division::divrem(q.data(), r.data(), dividend.limbs_.data(), an,
+                                     divisor.limbs_.data(), bn);
+
+        quotient->limbs_ = std::move(q);
+        quotient->negative_ = quotient_negative;
+        quotient->normalize();
+
+        remainder->limbs_ = std::move(r);
+        remainder->negative_ = remainder_negative;
+        remainder->normalize();
+    }
+};
+
+using BigInteger = BasicBigInteger<BIGINTEGER_DEFAULT_INLINE_LIMBS>;
+
+// Random probable primes of a given bit length. A search starts at a random odd number and walks
+// up through windows of WINDOW odd candidates. The start's residues modulo the first
+// SIEVE_PRIMES odd primes mark every candidate in the window with a small factor; the residues
+// then advance by the window width, so the start is divided only once. Survivors go to the
+// Baillie-PSW test. With several threads, each walks from its own random start and the first
+// prime found cancels the others. Every start is drawn from the caller's engine, under a lock
+// when threads share it, so the output is exactly as strong as that engine at any thread count.
+template <size_t InlineLimbs>
+class BasicPrimeGenerator
+{
+public:
+    using integer_type = BasicBigInteger<InlineLimbs>;
+    using limb_type = detail::LimbArithmetic::limb_type;
+
+    static constexpr size_t SIEVE_PRIMES = 2048;
+    static constexpr size_t WINDOW = 4096;
+
+    // threads == 0 uses every hardware thread.
+    explicit BasicPrimeGenerator(unsigned threads = 1)
+        : threads_(threads != 0 ? threads : std::max(1U, std::thread::hardware_concurrency()))
+    {
+    }
+
+    [[nodiscard]] unsigned threads() const noexcept { return threads_; }
+
+    // Random probable prime of exactly `bits` bits.
+    template <typename Engine>
+    [[nodiscard]] integer_type generate(size_t bits, Engine& engine) const
+    {
+        if (bits < 2)
+            throw std::domain_error("Prime needs at least two bits");
+
+        const integer_type bound = integer_type(1) << bits;
+        std::uniform_int_distribution<limb_type> distribution;
+        if (threads_ == 1)
+        {
+            const std::atomic<bool> never{false};
+            return *search_random(
+                bits, bound,
+                [&](std::vector<limb_type>& limbs) {
+                    for (auto& limb : limbs)
+                        limb = distribution(engine);
+                },
+                never);
+        }
+
+        std::atomic<bool> stop{false};
+        std::mutex mutex;
+        std::mutex engine_mutex;
+        std::optional<integer_type> result;
+        std::exception_ptr error;
+
+        // Draws are rare next to the sieving and testing between them, so the lock costs little.
+        const auto draw = [&](std::vector<limb_type>& limbs) {
+            std::lock_guard<std::mutex> lock(engine_mutex);
+            for (auto& limb : limbs)
+                limb = distribution(engine);
+        };
+
+        std::vector<std::thread> workers;
+        workers.reserve(threads_);
+        for (unsigned i = 0; i < threads_; ++i)
+        {
+            workers.emplace_back([&] {
+                try
+                {
+                    auto found = search_random(bits, bound, draw, stop);
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (found && !result)
+                        result = std::move(found);
+                }
+                catch (...)
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    error = std::current_exception();
+                }
+                stop = true;
+            });
+        }
+        for (auto& worker : workers)
+            worker.join();
+
+        if (error)
+            std::rethrow_exception(error);
+        return std::move(*result);
+    }
+
+    // Smallest probable prime >= start.
+    [[nodiscard]] integer_type next_prime(const integer_type& start) const
+    {
+        if (start <= integer_type(2))
+            return integer_type(2);
+
+        const std::atomic<bool> never{false};
+        return *search(start.is_even() ? start + 1 : start, nullptr, never);
+    }
+
+private:
+    static constexpr const auto& PRIMES = detail::SmallPrimes::ODD;
+    static_assert(SIEVE_PRIMES <= detail::SmallPrimes::COUNT);
+
+    // draw(limbs) fills limbs with random bits for each fresh start.
+    template <typename Draw>
+    std::optional<integer_type> search_random(size_t bits, const integer_type& bound,
+                                              const Draw& draw, const std::atomic<bool>& stop) const
+    {
+        std::vector<limb_type> limbs((bits + 63) / 64);
+        const size_t top = (bits - 1) % 64;
+
+        while (!stop.load(std::memory_order_relaxed))
+        {
+            draw(limbs);
+            limbs.back() &= top == 63 ? ~limb_type(0) : (limb_type(2) << top) - 1;
+            limbs.back() |= limb_type(1) << top;
+            limbs.front() |= 1;
+
+            // A walk that runs past 2^bits restarts from a fresh random point.
+            if (auto found = search(integer_type::from_limbs(limbs), &bound, stop))
+                return found;
+        }
+        return std::nullopt;
+    }
+
+    // First probable prime in [start, bound) for an odd start > 2, or nothing once the bound is
+    // passed or stop is set.
+    std::optional<integer_type> search(const integer_type& start, const integer_type* bound,
+                                       const std::atomic<bool>& stop) const
+    {
+        // A sieve prime at or above the start could be one of the candidates itself.
+        size_t count = SIEVE_PRIMES;
+        if (start.limb_count() == 1 && start.limbs()[0] <= PRIMES[SIEVE_PRIMES - 1])
+            count = static_cast<size_t>(
+                std::lower_bound(PRIMES.begin(), PRIMES.begin() + SIEVE_PRIMES, start.limbs()[0]) -
+                PRIMES.begin());
+
+        std::vector<uint32_t> residues(count);
+        compute_residues(start, residues);
+
+        std::vector<uint8_t> sieve(WINDOW);
+        for (integer_type base = start;; base += integer_type(2 * WINDOW))
+        {
+            std::fill(sieve.begin(), sieve.end(), uint8_t(0));
+            for (size_t i = 0; i < count; ++i)
+            {
+                // base + 2j = 0 mod p at j = -residue / 2 mod p.
+                const uint32_t p = PRIMES[i];
+                const uint32_t r = residues[i];
+                size_t j = static_cast<size_t>(r == 0 ? 0 : p - r) * ((p + 1) / 2) % p;
+                for (; j < WINDOW; j += p)
+                    sieve[j] = 1;
+                residues[i] = static_cast<uint32_t>((r + 2 * WINDOW) % p);
+            }
+
+            for (size_t j = 0; j < WINDOW; ++j)
+            {
+                if (sieve[j])
+                    continue;
+                if (stop.load(std::memory_order_relaxed))
+                    return std::nullopt;
+
+                integer_type candidate = base + integer_type(2 * j);
+                if (bound && candidate >= *bound)
+                    return std::nullopt;
+                if (detail::ArithmeticOperations::is_prime_baillie_psw(candidate))
+                    return candidate;
+            }
+        }
+    }
+
+    // residues[i] = start mod PRIMES[i], with several primes packed into each single-limb
+    // divisor so that every pass over the limbs of start serves a group of primes.
+    static void compute_residues(const integer_type& start, std::vector<uint32_t>& residues)
+    {
+        const auto limbs = start.limbs();
+        for (size_t first = 0; first < residues.size();)
+        {
+            limb_type product = 1;
+            size_t last = first;
+            while (last < residues.size() && product <= ~limb_type(0) / PRIMES[last])
+                product *= PRIMES[last++];
+
+            limb_type r = 0;
+            for (size_t i = limbs.size(); i-- > 0;)
+                detail::LimbArithmetic::div_wide(r, limbs[i], product, r);
+            for (size_t i = first; i < last; ++i)
+                residues[i] = static_cast<uint32_t>(r % PRIMES[i]);
+            first = last;
+        }
+    }
+
+    unsigned threads_;
+};
+
+using PrimeGenerator = BasicPrimeGenerator<BIGINTEGER_DEFAULT_INLINE_LIMBS>;
+
+// Primes in [low, high) for high <= 2^40 by a segmented sieve of Eratosthenes. A segment holds
+// the odd numbers of an interval as one bit each, so its bitmap fits the L1 data cache while
+// every base prime up to sqrt(high) crosses off its multiples. Iteration is lazy and sieves one
+// segment at a time; for_each() and count() hand whole blocks of segments to worker threads.
+class PrimeSieve
+{
+public:
+    static constexpr uint64_t MAX_LIMIT = uint64_t(1) << 40;
+    static constexpr size_t SEGMENT_BYTES = 32768;
+    static constexpr size_t SEGMENT_BITS = SEGMENT_BYTES * 8;
+    static constexpr size_t SEGMENT_WORDS = SEGMENT_BYTES / sizeof(uint64_t);
+    static constexpr size_t BLOCK_SEGMENTS = 8;
+
+private:
+    // Sieving state for consecutive segments: the index of the next odd multiple of every base
+    // prime relative to the current segment, so only the first segment needs divisions. The
+    // primes up to 13 are not crossed off one by one; a bitmap with their multiples already
+    // cleared is copied in from a pattern that repeats every 3 * 5 * 7 * 11 * 13 odd numbers.
+    class Segment
+    {
+    public:
+        Segment() = default;
+
+        // low must be odd.
+        Segment(std::span<const uint32_t> primes, uint64_t low)
+            : primes_(primes), next_(primes.size()), low_(low)
+        {
+            while (first_ < primes.size() && primes[first_] <= PRESIEVE_PRIMES.back())
+                ++first_;
+            for (size_t i = first_; i < primes.size(); ++i)
+            {
+                const uint64_t p = primes[i];
+                uint64_t start = (low + p - 1) / p * p;
+                if ((start & 1) == 0)
+                    start += p;
+                next_[i] = (std::max(start, p * p) - low) / 2;
+            }
+        }
+
+        [[nodiscard]] uint64_t low() const noexcept { return low_; }
+
+        // Sets words to the bitmap of the SEGMENT_BITS odd numbers from low() on, where a set bit
+        // is a prime, then moves on to the next segment.
+        void sieve(uint64_t* words) noexcept
+        {
+            presieve(words);
+            for (size_t i = first_; i < primes_.size(); ++i)
+            {
+                const uint64_t p = primes_[i];
+                uint64_t j = next_[i];
+                for (; j < SEGMENT_BITS; j += p)
+                    words[j / 64] &= ~(uint64_t(1) << (j % 64));
+                next_[i] = j - SEGMENT_BITS;
+            }
+            low_ += 2 * SEGMENT_BITS;
+        }
+
+    private:
+        static constexpr std::array<uint32_t, 5> PRESIEVE_PRIMES = {3, 5, 7, 11, 13};
+        static constexpr uint64_t PERIOD = 3 * 5 * 7 * 11 * 13;
+
+        // Bit k is set unless 2k + 1 has a factor among PRESIEVE_PRIMES, for k up to PERIOD + 128
+        // so that any 64 bits starting below PERIOD can be read from two neighbouring words.
+        static constexpr std::array<uint64_t, (PERIOD + 128) / 64 + 1> PATTERN = [] {
+            std::array<uint64_t, (PERIOD + 128) / 64 + 1> pattern{};
+            uint64_t* words = pattern.data();
+            for (size_t i = 0; i < pattern.size(); ++i)
+                words[i] = ~uint64_t(0);
+            for (const uint32_t p : PRESIEVE_PRIMES)
+            {
+                for (uint64_t k = p / 2; k < pattern.size() * 64; k += p)
+                    words[k / 64] &= ~(uint64_t(1) << (k % 64));
+            }
+            return pattern;
+        }();
+
+        void presieve(uint64_t* words) const noexcept
+        {
+            uint64_t position = (low_ / 2) % PERIOD;
+            for (size_t i = 0; i < SEGMENT_WORDS; ++i)
+            {
+                const uint64_t offset = position % 64;
+                const uint64_t* source = PATTERN.data() + position / 64;
+                words[i] = offset == 0 ? source[0]
+                                       : (source[0] >> offset) | (source[1] << (64 - offset));
+                position += 64;
+                if (position >= PERIOD)
+                    position -= PERIOD;
+            }
+
+            // The pattern clears the presieving primes themselves as well.
+            for (const uint32_t p : PRESIEVE_PRIMES)
+            {
+                if (p >= low_ && p < low_ + 2 * SEGMENT_BITS)
+                    words[(p - low_) / 128] |= uint64_t(1) << ((p - low_) / 2 % 64);
+            }
+        }
+
+        std::span<const uint32_t> primes_;
+        std::vector<uint64_t> next_;
+        uint64_t low_ = 0;
+        size_t first_ = 0;
+    };
+
+public:
+    // threads == 0 uses every hardware thread.
+    PrimeSieve(uint64_t low, uint64_t high, unsigned threads = 1)
+        : low_(low), high_(high),
+          threads_(threads != 0 ? threads : std::max(1U, std::thread::hardware_concurrency()))
+    {
+        if (high > MAX_LIMIT)
+            throw std::domain_error("Prime sieve limit must not exceed 2^40");
+    }
+
+    class iterator
+    {
+    public:
+        using value_type = uint64_t;
+        using difference_type = std::ptrdiff_t;
+        using iterator_concept = std::input_iterator_tag;
+
+        iterator() = default;
+
+        [[nodiscard]] uint64_t operator*() const noexcept { return current_; }
+
+        iterator& operator++()
+        {
+            advance();
+            return *this;
+        }
+
+        void operator++(int) { advance(); }
+
+        [[nodiscard]] bool operator==(std::default_sentinel_t) const noexcept { return done_; }
+
+    private:
+        friend class PrimeSieve;
+
+        iterator(const PrimeSieve& sieve)
+            : segment_(sieve.base_primes(), sieve.first_odd()), words_(SEGMENT_WORDS),
+              high_(sieve.high_)
+        {
+            if (sieve.low_ <= 2 && sieve.high_ > 2)
+            {
+                current_ = 2;
+                done_ = false;
+            }
+            else
+                advance();
+        }
+
+        void advance()
+        {
+            while (word_ == 0)
+            {
+                if (++index_ >= SEGMENT_WORDS)
+                {
+                    if (segment_.low() >= high_)
+                    {
+                        done_ = true;
+                        return;
+                    }
+                    base_ = segment_.low();
+                    segment_.sieve(words_.data());
+                    index_ = 0;
+                }
+                word_ = words_[index_];
+            }
+
+            const auto bit = static_cast<uint64_t>(std::countr_zero(word_));
+            word_ &= word_ - 1;
+            current_ = base_ + 2 * (index_ * 64 + bit);
+            done_ = current_ >= high_;
+        }
+
+        Segment segment_{};
+        std::vector<uint64_t> words_;
+        uint64_t high_ = 0;
+        uint64_t base_ = 0;
+        uint64_t current_ = 0;
+        uint64_t word_ = 0;
+        size_t index_ = SEGMENT_WORDS - 1;
+        bool done_ = true;
+    };
+
+    [[nodiscard]] iterator begin() const { return iterator(*this); }
+
+    [[nodiscard]] std::default_sentinel_t end() const noexcept { return {}; }
+
+    // Calls f(prime) for every prime in ascending order, always on the calling thread.
+    template <typename F>
+    void for_each(F&& f) const
+    {
+        if (low_ <= 2 && high_ > 2)
+            f(uint64_t(2));
+
+        sieve_blocks([&](uint64_t base, const uint64_t* words) {
+            for (size_t i = 0; i < SEGMENT_WORDS; ++i)
+            {
+                for (uint64_t word = words[i]; word != 0; word &= word - 1)
+                {
+                    const uint64_t prime =
+                        base + 2 * (i * 64 + static_cast<uint64_t>(std::countr_zero(word)));
+                    if (prime >= high_)
+                        return;
+                    f(prime);
+                }
+            }
+        });
+    }
+
+    [[nodiscard]] uint64_t count() const
+    {
+        uint64_t total = low_ <= 2 && high_ > 2 ? 1 : 0;
+        sieve_blocks([&](uint64_t base, const uint64_t* words) {
+            const uint64_t last = high_ - base;
+            for (size_t i = 0; i < SEGMENT_WORDS; ++i)
+            {
+                // Bit b of word i is base + 2 (64 i + b); drop the bits at or past high.
+                uint64_t word = words[i];
+                const uint64_t first = 128 * i;
+                if (first + 127 >= last)
+                {
+                    if (first >= last)
+                        break;
+                    const uint64_t keep = (last - first + 1) / 2;
+                    word &= keep >= 64 ? ~uint64_t(0) : (uint64_t(1) << keep) - 1;
+                }
+                total += static_cast<uint64_t>(std::popcount(word));
+            }
+        });
+        return total;
+    }
+
+    [[nodiscard]] std::vector<uint64_t> to_vector() const
+    {
+        std::vector<uint64_t> primes;
+        for_each([&](uint64_t prime) { primes.push_back(prime); });
+        return primes;
+    }
+
+private:
+    // Odd primes below 2^20, the base primes of every range up to MAX_LIMIT, computed once from
+    // the compile-time table.
+    static const std::vector<uint32_t>& cached_base_primes()
+    {
+        static const std::vector<uint32_t> primes = [] {
+            constexpr uint64_t LIMIT = uint64_t(1) << 20;
+            std::vector<uint32_t> result;
+            std::vector<uint64_t> words(SEGMENT_WORDS);
+            Segment segment(detail::SmallPrimes::ODD, 3);
+            while (segment.low() < LIMIT)
+            {
+                const uint64_t base = segment.low();
+                segment.sieve(words.data());
+                for (size_t i = 0; i < SEGMENT_WORDS; ++i)
+                {
+                    for (uint64_t word = words[i]; word != 0; word &= word - 1)
+                    {
+                        const uint64_t prime =
+                            base + 2 * (i * 64 + static_cast<uint64_t>(std::countr_zero(word)));
+                        if (prime < LIMIT)
+                            result.push_back(static_cast<uint32_t>(prime));
+                    }
+                }
+            }
+            return result;
+        }();
+        return primes;
+    }
+
+    // The odd primes p with p * p < high.
+    [[nodiscard]] std::span<const uint32_t> base_primes() const
+    {
+        const auto& primes = cached_base_primes();
+        const auto end = std::partition_point(primes.begin(), primes.end(), [this](uint32_t p) {
+            return uint64_t(p) * p < high_;
+        });
+        return {primes.data(), static_cast<size_t>(end - primes.begin())};
+    }
+
+    // The first odd number at or above max(low, 3), where the bitmaps start.
+    [[nodiscard]] uint64_t first_odd() const noexcept { return std::max<uint64_t>(low_, 3) | 1; }
+
+    // Sieves every segment of the range and calls visit(base, words) on the calling thread in
+    // ascending order. With several threads, each round gives every worker a block of
+    // BLOCK_SEGMENTS consecutive segments of its own.
+    template <typename Visit>
+    void sieve_blocks(Visit&& visit) const
+    {
+        const uint64_t first = first_odd();
+        if (first >= high_)
+            return;
+
+        const auto primes = base_primes();
+        const uint64_t span = 2 * SEGMENT_BITS;
+        const uint64_t segments = (high_ - first + span - 1) / span;
+
+        if (threads_ == 1)
+        {
+            std::vector<uint64_t> words(SEGMENT_WORDS);
+            Segment segment(primes, first);
+            for (uint64_t k = 0; k < segments; ++k)
+            {
+                const uint64_t base = segment.low();
+                segment.sieve(words.data());
+                visit(base, words.data());
+            }
+            return;
+        }
+
+        const size_t block_words = BLOCK_SEGMENTS * SEGMENT_WORDS;
+        std::vector<uint64_t> words(threads_ * block_words);
+        for (uint64_t round = 0; round < segments; round += uint64_t(threads_) * BLOCK_SEGMENTS)
+        {
+            const auto sieve_block = [&](unsigned t) {
+                const uint64_t begin = round + uint64_t(t) * BLOCK_SEGMENTS;
+                const uint64_t end = std::min(begin + BLOCK_SEGMENTS, segments);
+                if (begin >= end)
+                    return;
+                Segment segment(primes, first + begin * span);
+                for (uint64_t k = begin; k < end; ++k)
+                    segment.sieve(words.data() + (k - round) * SEGMENT_WORDS);
+            };
+
+            std::vector<std::thread> workers;
+            workers.reserve(threads_ - 1);
+            for (unsigned t = 1; t < threads_; ++t)
+                workers.emplace_back(sieve_block, t);
+            sieve_block(0);
+            for (auto& worker : workers)
+                worker.join();
+
+            const uint64_t end = std::min(round + uint64_t(threads_) * BLOCK_SEGMENTS, segments);
+            for (uint64_t k = round; k < end; ++k)
+                visit(first + k * span, words.data() + (k - round) * SEGMENT_WORDS);
+        }
+    }
+
+    uint64_t low_;
+    uint64_t high_;
+    unsigned threads_;
+};
 
 } // namespace Numerics
 
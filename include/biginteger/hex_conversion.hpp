@@ -1,17 +1,34 @@
 #ifndef BIGINTEGER_HEX_CONVERSION_HPP_zer7n0
 #define BIGINTEGER_HEX_CONVERSION_HPP_zer7n0
 
+#include <algorithm>
 #include <array>
 #include <bit>
 #include <cstddef>
 #include <cstdint>
 #include <limits>
+#include <iterator>
+#include <memory>
 #include <span>
 #include <stdexcept>
+#include <string>
 #include <string_view>
 #include <type_traits>
 #include <vector>
 
+// Bulk encoding and decoding of one-byte characters run SSSE3, AVX2, AVX-512 or NEON kernels
+// picked at run time, so no -m flags are needed. Define BIGINTEGER_NO_SIMD to build scalar only.
+#if !defined(BIGINTEGER_NO_SIMD) && defined(__GNUC__) && defined(__x86_64__)
+#define BIGINTEGER_HEX_SIMD_X86 1
+#define BIGINTEGER_HEX_TARGET_SSSE3 [[gnu::target("ssse3")]]
+#define BIGINTEGER_HEX_TARGET_AVX2 [[gnu::target("avx2")]]
+#define BIGINTEGER_HEX_TARGET_AVX512 [[gnu::target("avx512f,avx512bw")]]
+#include <immintrin.h>
+#elif !defined(BIGINTEGER_NO_SIMD) && defined(__aarch64__) && defined(__ARM_NEON)
+#define BIGINTEGER_HEX_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
 namespace hex
 {
 namespace detail
@@ -131,6 +148,17 @@ public:
 
     constexpr void clear() noexcept { size_ = 0; }
 
+    // Sets the size without touching the elements, for callers that write through data().
+    constexpr bool resize(size_type count) noexcept
+    {
+        if (count <= capacity())
+        {
+            size_ = count;
+            return true;
+        }
+        return false;
+    }
+
     constexpr bool push_back(const T& value) noexcept
     {
         if (size_ < capacity())
@@ -211,6 +239,344 @@ template <typename T>
     return (x >> r) | (x << (bits - r));
 }
 
+// Instruction sets for the bulk kernels, in increasing order of preference within an
+// architecture.
+enum class simd_level
+{
+    scalar,
+    neon,
+    ssse3,
+    avx2,
+    avx512
+};
+
+// Vector kernels over one-byte characters. encode turns count bytes into 2 * count uppercase
+// digits and decode turns 2 * count digits into count bytes. Both handle whole vectors only and
+// return how many bytes they covered; decode also stops before the first vector holding a
+// non-hex character, so the scalar loop that finishes the tail is the one to report it.
+class hex_kernels
+{
+public:
+    // Best level this CPU supports, detected once. AVX-512 counts only with the BW extension.
+    static simd_level best_level() noexcept
+    {
+        static const simd_level level = detect();
+        return level;
+    }
+
+    // The requested level, or the best available one when this CPU cannot run it.
+    static simd_level supported(simd_level requested) noexcept
+    {
+        const simd_level best = best_level();
+        if (requested >= best)
+            return best;
+        // Every x86 level below the best also runs; NEON never runs on x86.
+        return requested >= simd_level::ssse3 ? requested : simd_level::scalar;
+    }
+
+    static size_t encode(const uint8_t* in, size_t count, uint8_t* out, simd_level level) noexcept
+    {
+        return dispatch(level, [&](auto isa) { return isa.encode(in, count, out); });
+    }
+
+    static size_t decode(const uint8_t* in, size_t count, uint8_t* out, simd_level level) noexcept
+    {
+        return dispatch(level, [&](auto isa) { return isa.decode(in, count, out); });
+    }
+
+private:
+    static simd_level detect() noexcept
+    {
+#if defined(BIGINTEGER_HEX_SIMD_X86)
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw"))
+            return simd_level::avx512;
+        if (__builtin_cpu_supports("avx2"))
+            return simd_level::avx2;
+        if (__builtin_cpu_supports("ssse3"))
+            return simd_level::ssse3;
+#elif defined(BIGINTEGER_HEX_SIMD_NEON)
+        return simd_level::neon;
+#endif
+        return simd_level::scalar;
+    }
+
+    template <typename Kernel>
+    static size_t dispatch(simd_level level, [[maybe_unused]] Kernel&& kernel) noexcept
+    {
+        switch (supported(level))
+        {
+#if defined(BIGINTEGER_HEX_SIMD_X86)
+        case simd_level::avx512:
+            return kernel(avx512{});
+        case simd_level::avx2:
+            return kernel(avx2{});
+        case simd_level::ssse3:
+            return kernel(ssse3{});
+#elif defined(BIGINTEGER_HEX_SIMD_NEON)
+        case simd_level::neon:
+            return kernel(neon{});
+#endif
+        default:
+            return 0;
+        }
+    }
+
+    static const uint8_t* digits() noexcept
+    {
+        return reinterpret_cast<const uint8_t*>(hex_tables::encode_table<char>.data());
+    }
+
+#if defined(BIGINTEGER_HEX_SIMD_X86)
+    // Decoding classifies every character c twice: c - '0' is a digit below 10, and (c | 0x20) -
+    // 'a' is a letter below 6, which folds case. Unsigned "below" is min(x, bound - 1) == x, and
+    // multiply-add by 16 and 1 joins each pair of nibbles into a byte.
+    struct ssse3
+    {
+        BIGINTEGER_HEX_TARGET_SSSE3 static size_t encode(const uint8_t* in, size_t count,
+                                                         uint8_t* out) noexcept
+        {
+            const __m128i table = _mm_loadu_si128(reinterpret_cast<const __m128i*>(digits()));
+            const __m128i nibble = _mm_set1_epi8(0x0F);
+            size_t i = 0;
+            for (; i + 16 <= count; i += 16)
+            {
+                const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+                const __m128i high =
+                    _mm_shuffle_epi8(table, _mm_and_si128(_mm_srli_epi16(bytes, 4), nibble));
+                const __m128i low = _mm_shuffle_epi8(table, _mm_and_si128(bytes, nibble));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * i),
+                                 _mm_unpacklo_epi8(high, low));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * i + 16),
+                                 _mm_unpackhi_epi8(high, low));
+            }
+            return i;
+        }
+
+        BIGINTEGER_HEX_TARGET_SSSE3 static size_t decode(const uint8_t* in, size_t count,
+                                                         uint8_t* out) noexcept
+        {
+            const __m128i weights = _mm_set1_epi16(0x0110);
+            size_t i = 0;
+            for (; i + 16 <= count; i += 16)
+            {
+                __m128i valid_first;
+                __m128i valid_second;
+                const __m128i first = values(
+                    _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 2 * i)), valid_first);
+                const __m128i second =
+                    values(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 2 * i + 16)),
+                           valid_second);
+                if (_mm_movemask_epi8(_mm_and_si128(valid_first, valid_second)) != 0xFFFF)
+                    break;
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i),
+                                 _mm_packus_epi16(_mm_maddubs_epi16(first, weights),
+                                                  _mm_maddubs_epi16(second, weights)));
+            }
+            return i;
+        }
+
+        // Nibble values of the hex digits in chars, with all-ones bytes in valid where c is one.
+        BIGINTEGER_HEX_TARGET_SSSE3 static __m128i values(__m128i chars, __m128i& valid) noexcept
+        {
+            const __m128i digit = _mm_sub_epi8(chars, _mm_set1_epi8('0'));
+            const __m128i letter =
+                _mm_sub_epi8(_mm_or_si128(chars, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+            const __m128i is_digit = _mm_cmpeq_epi8(_mm_min_epu8(digit, _mm_set1_epi8(9)), digit);
+            const __m128i is_letter =
+                _mm_cmpeq_epi8(_mm_min_epu8(letter, _mm_set1_epi8(5)), letter);
+            valid = _mm_or_si128(is_digit, is_letter);
+            return _mm_or_si128(_mm_and_si128(is_digit, digit),
+                                _mm_and_si128(is_letter, _mm_add_epi8(letter, _mm_set1_epi8(10))));
+        }
+    };
+
+    // The same steps as ssse3, where byte unpacking and packing stay within 128-bit lanes, so
+    // whole lanes are put back in order afterwards.
+    struct avx2
+    {
+        BIGINTEGER_HEX_TARGET_AVX2 static size_t encode(const uint8_t* in, size_t count,
+                                                        uint8_t* out) noexcept
+        {
+            const __m256i table = _mm256_broadcastsi128_si256(
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(digits())));
+            const __m256i nibble = _mm256_set1_epi8(0x0F);
+            size_t i = 0;
+            for (; i + 32 <= count; i += 32)
+            {
+                const __m256i bytes =
+                    _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+                const __m256i high = _mm256_shuffle_epi8(
+                    table, _mm256_and_si256(_mm256_srli_epi16(bytes, 4), nibble));
+                const __m256i low = _mm256_shuffle_epi8(table, _mm256_and_si256(bytes, nibble));
+                const __m256i first = _mm256_unpacklo_epi8(high, low);
+                const __m256i second = _mm256_unpackhi_epi8(high, low);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 2 * i),
+                                    _mm256_permute2x128_si256(first, second, 0x20));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 2 * i + 32),
+                                    _mm256_permute2x128_si256(first, second, 0x31));
+            }
+            return i;
+        }
+
+        BIGINTEGER_HEX_TARGET_AVX2 static size_t decode(const uint8_t* in, size_t count,
+                                                        uint8_t* out) noexcept
+        {
+            const __m256i weights = _mm256_set1_epi16(0x0110);
+            size_t i = 0;
+            for (; i + 32 <= count; i += 32)
+            {
+                __m256i valid_first;
+                __m256i valid_second;
+                const __m256i first =
+                    values(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + 2 * i)),
+                           valid_first);
+                const __m256i second =
+                    values(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + 2 * i + 32)),
+                           valid_second);
+                if (_mm256_movemask_epi8(_mm256_and_si256(valid_first, valid_second)) != -1)
+                    break;
+                const __m256i bytes = _mm256_packus_epi16(_mm256_maddubs_epi16(first, weights),
+                                                          _mm256_maddubs_epi16(second, weights));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i),
+                                    _mm256_permute4x64_epi64(bytes, 0xD8));
+            }
+            return i;
+        }
+
+        BIGINTEGER_HEX_TARGET_AVX2 static __m256i values(__m256i chars, __m256i& valid) noexcept
+        {
+            const __m256i digit = _mm256_sub_epi8(chars, _mm256_set1_epi8('0'));
+            const __m256i letter = _mm256_sub_epi8(
+                _mm256_or_si256(chars, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+            const __m256i is_digit =
+                _mm256_cmpeq_epi8(_mm256_min_epu8(digit, _mm256_set1_epi8(9)), digit);
+            const __m256i is_letter =
+                _mm256_cmpeq_epi8(_mm256_min_epu8(letter, _mm256_set1_epi8(5)), letter);
+            valid = _mm256_or_si256(is_digit, is_letter);
+            return _mm256_blendv_epi8(_mm256_add_epi8(letter, _mm256_set1_epi8(10)), digit,
+                                      is_digit);
+        }
+    };
+
+    // AVX-512BW compares straight into mask registers, and a 64-bit permute restores the lane
+    // order across the whole register. GCC 12 flags the placeholder inside its own broadcast and
+    // permute intrinsics as uninitialised.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+    struct avx512
+    {
+        BIGINTEGER_HEX_TARGET_AVX512 static size_t encode(const uint8_t* in, size_t count,
+                                                          uint8_t* out) noexcept
+        {
+            const __m512i table =
+                _mm512_broadcast_i32x4(_mm_loadu_si128(reinterpret_cast<const __m128i*>(digits())));
+            const __m512i nibble = _mm512_set1_epi8(0x0F);
+            const __m512i first_order = _mm512_setr_epi64(0, 1, 8, 9, 2, 3, 10, 11);
+            const __m512i second_order = _mm512_setr_epi64(4, 5, 12, 13, 6, 7, 14, 15);
+            size_t i = 0;
+            for (; i + 64 <= count; i += 64)
+            {
+                const __m512i bytes = _mm512_loadu_si512(in + i);
+                const __m512i high = _mm512_shuffle_epi8(
+                    table, _mm512_and_si512(_mm512_srli_epi16(bytes, 4), nibble));
+                const __m512i low = _mm512_shuffle_epi8(table, _mm512_and_si512(bytes, nibble));
+                const __m512i first = _mm512_unpacklo_epi8(high, low);
+                const __m512i second = _mm512_unpackhi_epi8(high, low);
+                _mm512_storeu_si512(out + 2 * i,
+                                    _mm512_permutex2var_epi64(first, first_order, second));
+                _mm512_storeu_si512(out + 2 * i + 64,
+                                    _mm512_permutex2var_epi64(first, second_order, second));
+            }
+            return i;
+        }
+
+        BIGINTEGER_HEX_TARGET_AVX512 static size_t decode(const uint8_t* in, size_t count,
+                                                          uint8_t* out) noexcept
+        {
+            const __m512i weights = _mm512_set1_epi16(0x0110);
+            const __m512i order = _mm512_setr_epi64(0, 2, 4, 6, 1, 3, 5, 7);
+            size_t i = 0;
+            for (; i + 64 <= count; i += 64)
+            {
+                __mmask64 valid_first;
+                __mmask64 valid_second;
+                const __m512i first = values(_mm512_loadu_si512(in + 2 * i), valid_first);
+                const __m512i second = values(_mm512_loadu_si512(in + 2 * i + 64), valid_second);
+                if ((valid_first & valid_second) != ~__mmask64(0))
+                    break;
+                const __m512i bytes = _mm512_packus_epi16(_mm512_maddubs_epi16(first, weights),
+                                                          _mm512_maddubs_epi16(second, weights));
+                _mm512_storeu_si512(out + i, _mm512_permutexvar_epi64(order, bytes));
+            }
+            return i;
+        }
+
+        BIGINTEGER_HEX_TARGET_AVX512 static __m512i values(__m512i chars,
+                                                           __mmask64& valid) noexcept
+        {
+            const __m512i digit = _mm512_sub_epi8(chars, _mm512_set1_epi8('0'));
+            const __m512i letter = _mm512_sub_epi8(
+                _mm512_or_si512(chars, _mm512_set1_epi8(0x20)), _mm512_set1_epi8('a'));
+            const __mmask64 is_digit = _mm512_cmplt_epu8_mask(digit, _mm512_set1_epi8(10));
+            const __mmask64 is_letter = _mm512_cmplt_epu8_mask(letter, _mm512_set1_epi8(6));
+            valid = is_digit | is_letter;
+            return _mm512_mask_blend_epi8(is_digit, _mm512_add_epi8(letter, _mm512_set1_epi8(10)),
+                                          digit);
+        }
+    };
+#pragma GCC diagnostic pop
+#elif defined(BIGINTEGER_HEX_SIMD_NEON)
+    // Interleaving loads and stores split and join the two digits of every byte directly.
+    struct neon
+    {
+        static size_t encode(const uint8_t* in, size_t count, uint8_t* out) noexcept
+        {
+            const uint8x16_t table = vld1q_u8(digits());
+            size_t i = 0;
+            for (; i + 16 <= count; i += 16)
+            {
+                const uint8x16_t bytes = vld1q_u8(in + i);
+                uint8x16x2_t chars;
+                chars.val[0] = vqtbl1q_u8(table, vshrq_n_u8(bytes, 4));
+                chars.val[1] = vqtbl1q_u8(table, vandq_u8(bytes, vdupq_n_u8(0x0F)));
+                vst2q_u8(out + 2 * i, chars);
+            }
+            return i;
+        }
+
+        static size_t decode(const uint8_t* in, size_t count, uint8_t* out) noexcept
+        {
+            size_t i = 0;
+            for (; i + 16 <= count; i += 16)
+            {
+                const uint8x16x2_t chars = vld2q_u8(in + 2 * i);
+                uint8x16_t valid_high;
+                uint8x16_t valid_low;
+                const uint8x16_t high = values(chars.val[0], valid_high);
+                const uint8x16_t low = values(chars.val[1], valid_low);
+                if (vminvq_u8(vandq_u8(valid_high, valid_low)) != 0xFF)
+                    break;
+                vst1q_u8(out + i, vorrq_u8(vshlq_n_u8(high, 4), low));
+            }
+            return i;
+        }
+
+        static uint8x16_t values(uint8x16_t chars, uint8x16_t& valid) noexcept
+        {
+            const uint8x16_t digit = vsubq_u8(chars, vdupq_n_u8('0'));
+            const uint8x16_t letter =
+                vsubq_u8(vorrq_u8(chars, vdupq_n_u8(0x20)), vdupq_n_u8('a'));
+            const uint8x16_t is_digit = vcltq_u8(digit, vdupq_n_u8(10));
+            const uint8x16_t is_letter = vcltq_u8(letter, vdupq_n_u8(6));
+            valid = vorrq_u8(is_digit, is_letter);
+            return vbslq_u8(is_digit, digit, vaddq_u8(letter, vdupq_n_u8(10)));
+        }
+    };
+#endif
+};
+
 } // namespace detail
 
 template <detail::CharType CharT = char>
@@ -271,6 +637,19 @@ public:
         using value_type = typename std::iterator_traits<InputIt>::value_type;
         static_assert(detail::ByteType<value_type>, "Iterator value type must be a byte type");
 
+        if constexpr (std::contiguous_iterator<InputIt>)
+        {
+            if (!std::is_constant_evaluated())
+            {
+                const auto count = std::min<size_t>(static_cast<size_t>(last - first),
+                                                    result.capacity() / 2);
+                result.resize(2 * count);
+                encode_bytes(reinterpret_cast<const uint8_t*>(std::to_address(first)), count,
+                             result.data(), detail::hex_kernels::best_level());
+                return result;
+            }
+        }
+
         while (first != last && result.size() < result.capacity() - 1)
         {
             const auto byte = static_cast<uint8_t>(*first++);
@@ -293,6 +672,16 @@ public:
         }
 
         Container result;
+        if constexpr (requires { result.resize(size_t{}); result.data(); })
+        {
+            if (!std::is_constant_evaluated())
+            {
+                result.resize(hex.size() / 2);
+                decode_bytes(hex, reinterpret_cast<uint8_t*>(std::to_address(result.data())),
+                             detail::hex_kernels::best_level());
+                return result;
+            }
+        }
         result.reserve(hex.size() / 2);
 
         for (size_t i = 0; i < hex.size(); i += 2)
@@ -311,6 +700,40 @@ public:
         return result;
     }
 
+    // Writes the 2 * bytes.size() digits of bytes to out and returns one past the last one
+    // written. One-byte character types run the widest vector kernel level allows.
+    static CharT* encode_to(std::span<const byte_type> bytes, CharT* out,
+                            detail::simd_level level = detail::hex_kernels::best_level()) noexcept
+    {
+        encode_bytes(reinterpret_cast<const uint8_t*>(bytes.data()), bytes.size(), out, level);
+        return out + 2 * bytes.size();
+    }
+
+    // All of bytes as one string of 2 * bytes.size() digits.
+    template <typename String = std::basic_string<CharT>>
+    [[nodiscard]] static String encode_string(std::span<const byte_type> bytes)
+    {
+        String result;
+        result.resize(2 * bytes.size());
+        encode_to(bytes, result.data());
+        return result;
+    }
+
+    // Writes the hex.size() / 2 bytes hex spells to out and returns one past the last one
+    // written. Throws std::invalid_argument for an odd length or a non-hex character, in which
+    // case out may be partly written.
+    static byte_type* decode_to(std::basic_string_view<CharT> hex, byte_type* out,
+                                detail::simd_level level = detail::hex_kernels::best_level())
+    {
+        if (hex.size() % 2 != 0)
+        {
+            throw std::invalid_argument("Invalid hex string length - must be even");
+        }
+
+        decode_bytes(hex, reinterpret_cast<uint8_t*>(out), level);
+        return out + hex.size() / 2;
+    }
+
     template <detail::IntegralType T>
     [[nodiscard]] static constexpr T decode_integral(std::basic_string_view<CharT> hex)
     {
@@ -375,6 +798,55 @@ public:
 
         return static_cast<T>(result);
     }
+
+private:
+    static void encode_bytes(const uint8_t* in, size_t count, CharT* out,
+                             [[maybe_unused]] detail::simd_level level) noexcept
+    {
+        size_t i = 0;
+        if constexpr (sizeof(CharT) == 1)
+        {
+            i = detail::hex_kernels::encode(in, count, reinterpret_cast<uint8_t*>(out), level);
+        }
+
+        for (; i < count; ++i)
+        {
+            out[2 * i] = tables::template encode_table<CharT>[in[i] >> 4];
+            out[2 * i + 1] = tables::template encode_table<CharT>[in[i] & 0xF];
+        }
+    }
+
+    static void decode_bytes(std::basic_string_view<CharT> hex, uint8_t* out,
+                             [[maybe_unused]] detail::simd_level level)
+    {
+        const size_t count = hex.size() / 2;
+        size_t i = 0;
+        if constexpr (sizeof(CharT) == 1)
+        {
+            i = detail::hex_kernels::decode(reinterpret_cast<const uint8_t*>(hex.data()), count,
+                                            out, level);
+        }
+
+        for (; i < count; ++i)
+        {
+            const auto high = digit_value(hex[2 * i]);
+            const auto low = digit_value(hex[2 * i + 1]);
+
+            if (high == 0xFF || low == 0xFF)
+            {
+                throw std::invalid_argument("Invalid hex character");
+            }
+
+            out[i] = static_cast<uint8_t>((high << 4) | low);
+        }
+    }
+
+    // Like the decode table, but wide characters outside it are invalid rather than truncated.
+    static constexpr uint8_t digit_value(CharT c) noexcept
+    {
+        const auto uc = static_cast<std::make_unsigned_t<CharT>>(c);
+        return uc < tables::table_size ? tables::template decode_table<CharT>[uc] : 0xFF;
+    }
 };
 
 using hex_converter = basic_hex_converter<char>;
@@ -1,5 +1,8 @@
+#include <algorithm>
 #include <biginteger/biginteger.hpp>
 #include <gtest/gtest.h>
+#include <numeric>
+#include <random>
 #include <tuple>
 
 TEST(ArithmeticOperationsTest, ExtendedGCD)
@@ -146,6 +149,127 @@ TEST(ArithmeticOperationsTest, IsPrimeMillerRabin)
     EXPECT_FALSE(ArithmeticOperations::is_prime_miller_rabin(1729));
 }
 
+TEST(ArithmeticOperationsTest, IsPrimeMillerRabinIsExactBelow64Bits)
+{
+    using namespace Numerics::detail;
+
+    constexpr uint32_t LIMIT = 100000;
+    std::vector<bool> composite(LIMIT, false);
+    composite[0] = composite[1] = true;
+    for (uint32_t p = 2; p * p < LIMIT; ++p)
+    {
+        if (!composite[p])
+            for (uint32_t q = p * p; q < LIMIT; q += p)
+                composite[q] = true;
+    }
+    for (uint32_t n = 0; n < LIMIT; ++n)
+        EXPECT_EQ(ArithmeticOperations::is_prime_miller_rabin(n), !composite[n]) << n;
+
+    // Strong pseudoprimes to one or more of the bases, and Carmichael numbers.
+    const uint64_t pseudoprimes[] = {2047,          3277,           4033,
+                                     4681,          8321,           3215031751,
+                                     2152302898747, 3474749660383,  341550071728321,
+                                     561,           41041,          825265,
+                                     321197185,     4759123141,     3825123056546413051};
+    for (uint64_t n : pseudoprimes)
+        EXPECT_FALSE(ArithmeticOperations::is_prime_miller_rabin(n)) << n;
+
+    const uint64_t primes[] = {4294967291,          4294967311,           999999999989,
+                               (uint64_t(1) << 61) - 1, 18446744073709551557ULL};
+    for (uint64_t p : primes)
+    {
+        EXPECT_TRUE(ArithmeticOperations::is_prime_miller_rabin(p)) << p;
+        EXPECT_FALSE(ArithmeticOperations::is_prime_miller_rabin(p * 3)) << p;
+    }
+
+    EXPECT_FALSE(ArithmeticOperations::is_prime_miller_rabin(uint64_t(4294967291) * 4294967279));
+    EXPECT_FALSE(ArithmeticOperations::is_prime_miller_rabin(uint32_t(65521) * 65521));
+    EXPECT_FALSE(ArithmeticOperations::is_prime_miller_rabin(uint16_t(131 * 131)));
+    EXPECT_TRUE(ArithmeticOperations::is_prime_miller_rabin(uint8_t(251)));
+    EXPECT_TRUE(ArithmeticOperations::is_prime_miller_rabin(int64_t(9223372036854775783)));
+    EXPECT_FALSE(ArithmeticOperations::is_prime_miller_rabin(int64_t(-9223372036854775807 - 1)));
+}
+
+TEST(ArithmeticOperationsTest, JacobiSymbol)
+{
+    using namespace Numerics::detail;
+    using Numerics::BigInteger;
+
+    EXPECT_EQ(ArithmeticOperations::jacobi_symbol(0, 1), 1);
+    EXPECT_EQ(ArithmeticOperations::jacobi_symbol(2, 7), 1);
+    EXPECT_EQ(ArithmeticOperations::jacobi_symbol(3, 7), -1);
+    EXPECT_EQ(ArithmeticOperations::jacobi_symbol(6, 15), 0);
+    EXPECT_EQ(ArithmeticOperations::jacobi_symbol(-1, 7), -1);
+    EXPECT_EQ(ArithmeticOperations::jacobi_symbol(1001, 9907), -1);
+    EXPECT_THROW(ArithmeticOperations::jacobi_symbol(3, 8), std::domain_error);
+    EXPECT_THROW(ArithmeticOperations::jacobi_symbol(3, -7), std::domain_error);
+
+    // Euler's criterion: (a / p) = a^((p - 1) / 2) mod p for a prime p.
+    const BigInteger p = (BigInteger(1) << 127) - 1;
+    std::mt19937_64 gen(2718);
+    for (int i = 0; i < 50; ++i)
+    {
+        const BigInteger a =
+            BigInteger::from_limbs(std::vector<uint64_t>{gen(), gen(), gen()}) * (i % 2 ? 1 : -1);
+        const BigInteger euler = ArithmeticOperations::modular_pow(a, (p - 1) >> 1, p);
+        EXPECT_EQ(ArithmeticOperations::jacobi_symbol(a, p), euler == BigInteger(1) ? 1 : -1);
+
+        const int64_t x = static_cast<int64_t>(gen());
+        const auto m = static_cast<int64_t>((gen() >> 2) | 1);
+        EXPECT_EQ(ArithmeticOperations::jacobi_symbol(BigInteger(x), BigInteger(m)),
+                  ArithmeticOperations::jacobi_symbol(x, m));
+    }
+
+    // Multiplicative in the modulus.
+    const BigInteger m1("340282366920938463463374607431768211507");
+    const BigInteger m2("1267650600228229401496703205653");
+    const BigInteger a("98765432109876543210987654321");
+    const int first = ArithmeticOperations::jacobi_symbol(a, m1);
+    const int second = ArithmeticOperations::jacobi_symbol(a, m2);
+    EXPECT_EQ(ArithmeticOperations::jacobi_symbol(a, m1 * m2), first * second);
+    EXPECT_EQ(ArithmeticOperations::jacobi_symbol(m1 * 3, m1 * m2), 0);
+}
+
+TEST(ArithmeticOperationsTest, BailliePswPrimality)
+{
+    using namespace Numerics::detail;
+    using Numerics::BigInteger;
+
+    const auto mersenne = [](size_t p) { return (BigInteger(1) << p) - 1; };
+    for (size_t p : {61, 89, 107, 127, 521, 607, 1279})
+        EXPECT_TRUE(ArithmeticOperations::is_prime_baillie_psw(mersenne(p))) << p;
+    for (size_t p : {64, 67, 101, 257, 1277})
+        EXPECT_FALSE(ArithmeticOperations::is_prime_baillie_psw(mersenne(p))) << p;
+
+    EXPECT_FALSE(ArithmeticOperations::is_prime_baillie_psw(BigInteger(0)));
+    EXPECT_FALSE(ArithmeticOperations::is_prime_baillie_psw(BigInteger(1)));
+    EXPECT_TRUE(ArithmeticOperations::is_prime_baillie_psw(BigInteger(2)));
+    EXPECT_FALSE(ArithmeticOperations::is_prime_baillie_psw(-mersenne(127)));
+    EXPECT_FALSE(ArithmeticOperations::is_prime_baillie_psw(mersenne(127) * 251));
+    EXPECT_FALSE(ArithmeticOperations::is_prime_baillie_psw(mersenne(127) * mersenne(89)));
+    EXPECT_FALSE(ArithmeticOperations::is_prime_baillie_psw(mersenne(61) * mersenne(61)));
+
+    // Strong pseudoprimes to every prime base up to 37 and 41, which only the Lucas half rejects.
+    const BigInteger psi12("318665857834031151167461");
+    const BigInteger psi13("3317044064679887385961981");
+    for (const auto& n : {psi12, psi13})
+    {
+        EXPECT_EQ(ArithmeticOperations::modular_pow(BigInteger(2), n - 1, n), BigInteger(1));
+        EXPECT_FALSE(ArithmeticOperations::is_prime_baillie_psw(n));
+    }
+
+    // The first prime above 2^64, and products of two primes just below 2^64.
+    const BigInteger two_64 = BigInteger(1) << 64;
+    for (int i = 1; i < 13; i += 2)
+        EXPECT_FALSE(ArithmeticOperations::is_prime_baillie_psw(two_64 + i)) << i;
+    EXPECT_TRUE(ArithmeticOperations::is_prime_baillie_psw(two_64 + 13));
+
+    const BigInteger p1("18446744073709551557");
+    const BigInteger p2("18446744073709551533");
+    EXPECT_FALSE(ArithmeticOperations::is_prime_baillie_psw(p1 * p2));
+    EXPECT_FALSE(ArithmeticOperations::is_prime_baillie_psw(p1 * p2 * p2));
+}
+
 TEST(ArithmeticOperationsTest, ModularPow)
 {
     using namespace Numerics::detail;
@@ -181,3 +305,391 @@ TEST(ArithmeticOperationsTest, ModularPow)
         }
     }
 }
+
+TEST(ArithmeticOperationsTest, ModularSquare)
+{
+    using namespace Numerics::detail;
+
+    EXPECT_EQ(ArithmeticOperations::modular_square<int>(12, 13), 144 % 13);
+    EXPECT_EQ(ArithmeticOperations::modular_square<uint64_t>(~uint64_t(0), 1000000007),
+              ArithmeticOperations::modular_multiply<uint64_t>(~uint64_t(0), ~uint64_t(0),
+                                                                1000000007));
+}
+
+TEST(ArithmeticOperationsTest, BigIntegerModularPow)
+{
+    using namespace Numerics::detail;
+    using Numerics::BigInteger;
+
+    // 2^(p-1) = 1 mod p for the Mersenne prime 2^521 - 1, and 3^(2^127 - 1) mod 2^127 - 1 = 3^1.
+    const BigInteger m521 = (BigInteger(1) << 521) - 1;
+    EXPECT_EQ(ArithmeticOperations::modular_pow(BigInteger(2), m521 - 1, m521), BigInteger(1));
+
+    const BigInteger m127 = (BigInteger(1) << 127) - 1;
+    EXPECT_EQ(ArithmeticOperations::modular_pow(BigInteger(3), m127, m127), BigInteger(3));
+
+    EXPECT_EQ(ArithmeticOperations::modular_pow(BigInteger(-2), BigInteger(3), BigInteger(7)),
+              BigInteger(6));
+    EXPECT_EQ(ArithmeticOperations::modular_pow(BigInteger(5), BigInteger(0), BigInteger(1)),
+              BigInteger(0));
+
+    // Even moduli bypass Montgomery form: 3 has order 2^(k-2) modulo 2^k.
+    const BigInteger two300 = BigInteger(1) << 300;
+    EXPECT_EQ(ArithmeticOperations::modular_pow(BigInteger(3), BigInteger(1) << 298, two300),
+              BigInteger(1));
+    EXPECT_EQ(ArithmeticOperations::modular_pow(BigInteger(-7), BigInteger(101), two300 * 3),
+              two300 * 3 - BigInteger(7).pow(101) % (two300 * 3));
+
+    const BigInteger x("123456789012345678901234567890");
+    EXPECT_EQ(ArithmeticOperations::modular_multiply(x, x, m127),
+              ArithmeticOperations::modular_multiply(x, BigInteger(x), m127));
+
+    EXPECT_THROW(ArithmeticOperations::modular_pow(BigInteger(2), BigInteger(3), BigInteger(0)),
+                 std::domain_error);
+    EXPECT_THROW(ArithmeticOperations::modular_pow(BigInteger(2), BigInteger(-1), BigInteger(5)),
+                 std::domain_error);
+}
+
+TEST(ArithmeticOperationsTest, BarrettReducerMatchesRemainder)
+{
+    using namespace Numerics::detail;
+
+    std::mt19937_64 gen(77);
+    for (int i = 0; i < 10000; ++i)
+    {
+        const uint64_t modulus = std::max<uint64_t>(gen() >> (gen() % 64), 1);
+        const BarrettReducer<uint64_t> reducer(modulus);
+        const uint64_t a = gen();
+        const uint64_t b = i % 3 == 0 ? modulus - 1 : gen();
+
+        uint64_t high;
+        uint64_t expected;
+        const uint64_t low = LimbArithmetic::mul_wide(a % modulus, b % modulus, high);
+        LimbArithmetic::div_wide(high, low, modulus, expected);
+        EXPECT_EQ(reducer.multiply(a, b), expected);
+        EXPECT_EQ(reducer.reduce(a), a % modulus);
+    }
+
+    const BarrettReducer<uint32_t> even(1u << 20);
+    EXPECT_EQ(even.square(0xFFFFFFFFu), 1u);
+    EXPECT_EQ(BarrettReducer<uint8_t>(1).multiply(200, 100), 0);
+    EXPECT_EQ(BarrettReducer<uint16_t>(65535).multiply(65534, 65534), 1);
+    EXPECT_THROW(BarrettReducer<uint64_t>(0), std::domain_error);
+}
+
+TEST(ArithmeticOperationsTest, BarrettReducerHandlesBigIntegers)
+{
+    using namespace Numerics::detail;
+    using Numerics::BigInteger;
+
+    const BigInteger modulus = (BigInteger(1) << 3000) - BigInteger("12345678901234567890");
+    const BarrettReducer<BigInteger> reducer(modulus);
+    const BigInteger a = (BigInteger(1) << 2999) + 987654321;
+    const BigInteger b = modulus - 2;
+
+    EXPECT_EQ(reducer.multiply(a, b), a * b % modulus);
+    EXPECT_EQ(reducer.square(b), BigInteger(4));
+    EXPECT_EQ(reducer.reduce(-a), modulus - a);
+    EXPECT_EQ(reducer.reduce(a << 5000), (a << 5000) % modulus);
+
+    const BarrettReducer<BigInteger> even(BigInteger(1) << 200);
+    EXPECT_EQ(even.multiply(a % even.modulus(), BigInteger(3)), (a * 3) % even.modulus());
+    EXPECT_THROW(BarrettReducer<BigInteger>(BigInteger(-5)), std::domain_error);
+}
+
+TEST(ArithmeticOperationsTest, UnsignedModularPowUsesFullWidth)
+{
+    using namespace Numerics::detail;
+
+    // 2^64 - 59 is prime, so Fermat's little theorem holds for every base.
+    const uint64_t p = 0xFFFFFFFFFFFFFFC5ULL;
+    for (uint64_t base : {uint64_t(2), uint64_t(3), uint64_t(0xDEADBEEFCAFEBABE), p - 1})
+        EXPECT_EQ(ArithmeticOperations::modular_pow<uint64_t>(base, p - 1, p), 1U);
+
+    EXPECT_EQ(ArithmeticOperations::modular_pow<uint64_t>(5, 0, 1), 0U);
+    EXPECT_EQ(ArithmeticOperations::modular_multiply<uint64_t>(p - 1, p - 1, p), 1U);
+    EXPECT_EQ(ArithmeticOperations::modular_pow<uint32_t>(3, 200, 1000), 1U);
+}
+
+TEST(ArithmeticOperationsTest, NativeModularKernelsMatchBigInteger)
+{
+    using namespace Numerics::detail;
+    using Numerics::BigInteger;
+
+    const auto big = [](uint64_t x) { return BigInteger::from_limbs(std::vector<uint64_t>{x}); };
+
+    std::mt19937_64 gen(4242);
+    for (int i = 0; i < 2000; ++i)
+    {
+        const uint64_t a = gen();
+        const uint64_t b = gen() >> (gen() % 64);
+        const uint64_t m = (gen() >> (gen() % 64)) | (i % 2);
+        if (m == 0)
+            continue;
+
+        EXPECT_EQ(big(ArithmeticOperations::modular_multiply(a, b, m)), big(a) * big(b) % big(m));
+
+        const auto a32 = static_cast<uint32_t>(a);
+        const auto b32 = static_cast<uint32_t>(b);
+        const auto m32 = static_cast<uint32_t>(m) | 1;
+        EXPECT_EQ(ArithmeticOperations::modular_multiply(a32, b32, m32),
+                  static_cast<uint32_t>(uint64_t(a32) * b32 % m32));
+
+        // Signed operands take the sign of the exact product, as the built-in % would.
+        const auto sa = static_cast<int64_t>(a);
+        const auto sb = static_cast<int64_t>(b) * (i % 3 == 0 ? -1 : 1);
+        const auto sm = static_cast<int64_t>(m >> 1) + 1;
+        EXPECT_EQ(BigInteger(ArithmeticOperations::modular_multiply(sa, sb, sm)),
+                  BigInteger(sa) * BigInteger(sb) % BigInteger(sm));
+
+        const uint64_t e = gen() % 200;
+        BigInteger expected = BigInteger(1) % big(m);
+        for (uint64_t k = 0; k < e; ++k)
+            expected = expected * big(a) % big(m);
+        EXPECT_EQ(big(ArithmeticOperations::modular_pow(a, e, m)), expected);
+    }
+
+    EXPECT_THROW(ArithmeticOperations::modular_multiply<uint64_t>(3, 4, 0), std::domain_error);
+    EXPECT_THROW(ArithmeticOperations::modular_multiply<int>(3, 4, 0), std::domain_error);
+    EXPECT_EQ(ArithmeticOperations::modular_multiply<int64_t>(INT64_MIN, INT64_MIN, INT64_MAX), 1);
+    EXPECT_EQ(ArithmeticOperations::modular_pow<int64_t>(-2, 3, 5), -3);
+}
+
+TEST(ArithmeticOperationsTest, BinaryGcdMatchesEuclid)
+{
+    using namespace Numerics::detail;
+
+    std::mt19937_64 gen(99);
+    for (int i = 0; i < 10000; ++i)
+    {
+        const auto a = static_cast<int64_t>(gen() >> (gen() % 63)) * (i % 3 == 0 ? -1 : 1);
+        const auto b = static_cast<int64_t>(gen() >> (gen() % 63));
+        EXPECT_EQ(ArithmeticOperations::gcd(a, b), std::gcd(a, b));
+
+        const uint32_t c = static_cast<uint32_t>(gen());
+        const uint32_t d = static_cast<uint32_t>(gen()) << (gen() % 16);
+        EXPECT_EQ(ArithmeticOperations::gcd(c, d), std::gcd(c, d));
+    }
+
+    EXPECT_EQ(ArithmeticOperations::gcd(0, 0), 0);
+    EXPECT_EQ(ArithmeticOperations::gcd(-12, 0), 12);
+    EXPECT_EQ(ArithmeticOperations::gcd<uint64_t>(uint64_t(1) << 63, 3ULL << 40), 1ULL << 40);
+}
+
+TEST(ArithmeticOperationsTest, ModularInverseSupportsUnsignedAndEvenModuli)
+{
+    using namespace Numerics::detail;
+
+    // 2^64 - 59 exceeds every signed 64-bit value.
+    const uint64_t p = 0xFFFFFFFFFFFFFFC5ULL;
+    for (uint64_t a : {uint64_t(2), uint64_t(0xDEADBEEFCAFEBABE), p - 1})
+    {
+        const uint64_t inverse = ArithmeticOperations::modular_inverse(a, p);
+        EXPECT_EQ(ArithmeticOperations::modular_multiply(a, inverse, p), 1U);
+    }
+
+    EXPECT_EQ(ArithmeticOperations::modular_inverse<uint32_t>(3, 1U << 31), 715827883U);
+    EXPECT_EQ(ArithmeticOperations::modular_inverse<uint32_t>(6, 1U << 31), 0U);
+    EXPECT_EQ(ArithmeticOperations::modular_inverse<int64_t>(-3, 1000), 333);
+    EXPECT_EQ(ArithmeticOperations::modular_inverse<int>(5, 1), 0);
+    EXPECT_THROW(ArithmeticOperations::modular_inverse<int>(3, 0), std::domain_error);
+    EXPECT_THROW(ArithmeticOperations::modular_inverse<int>(3, -7), std::domain_error);
+}
+
+TEST(ArithmeticOperationsTest, BatchModularInverse)
+{
+    using namespace Numerics::detail;
+    using Numerics::BigInteger;
+
+    std::mt19937_64 gen(1618);
+
+    // Odd prime, even and odd composite moduli, and the trivial modulus.
+    for (uint64_t m : {uint64_t(0xFFFFFFFFFFFFFFC5ULL), uint64_t(1) << 40, uint64_t(3 * 5 * 7 * 11),
+                       uint64_t(1)})
+    {
+        std::vector<uint64_t> values(200);
+        for (auto& x : values)
+            x = gen() % 4 == 0 ? (gen() % 8) * 3 : gen();
+        const auto original = values;
+
+        const auto rejected = ArithmeticOperations::batch_modular_inverse(std::span(values), m);
+
+        std::vector<size_t> expected;
+        for (size_t i = 0; i < values.size(); ++i)
+        {
+            const uint64_t inverse = ArithmeticOperations::modular_inverse(original[i], m);
+            EXPECT_EQ(values[i], inverse) << "m=" << m << " i=" << i;
+            if (inverse == 0)
+                expected.push_back(i);
+        }
+        EXPECT_EQ(rejected, expected) << "m=" << m;
+    }
+
+    std::vector<uint32_t> small = {3, 0, 10, 7, 1};
+    EXPECT_EQ(ArithmeticOperations::batch_modular_inverse<uint32_t>(small, 11),
+              std::vector<size_t>{1});
+    EXPECT_EQ(small, (std::vector<uint32_t>{4, 0, 10, 8, 1}));
+
+    std::vector<uint64_t> empty;
+    EXPECT_TRUE(ArithmeticOperations::batch_modular_inverse<uint64_t>(empty, 7).empty());
+    EXPECT_THROW(ArithmeticOperations::batch_modular_inverse<uint64_t>(empty, 0),
+                 std::domain_error);
+
+    const BigInteger p = (BigInteger(1) << 127) - 1;
+    for (const BigInteger& m : {p, p * BigInteger(999), p * BigInteger(1000)})
+    {
+        std::vector<BigInteger> values;
+        for (int i = 0; i < 50; ++i)
+        {
+            BigInteger x = BigInteger::from_limbs(std::vector<uint64_t>{gen(), gen(), gen()});
+            values.push_back(i % 7 == 0 ? -x : i % 11 == 0 ? x * p : x);
+        }
+        const auto original = values;
+
+        const auto rejected = ArithmeticOperations::batch_modular_inverse(std::span(values), m);
+
+        std::vector<size_t> expected;
+        for (size_t i = 0; i < values.size(); ++i)
+        {
+            const BigInteger inverse = ArithmeticOperations::modular_inverse(original[i], m);
+            EXPECT_EQ(values[i], inverse) << "i=" << i;
+            if (inverse.is_zero())
+                expected.push_back(i);
+        }
+        EXPECT_EQ(rejected, expected);
+    }
+
+    std::vector<BigInteger> negative_modulus = {BigInteger(3)};
+    EXPECT_THROW(ArithmeticOperations::batch_modular_inverse(std::span(negative_modulus),
+                                                             BigInteger(-7)),
+                 std::domain_error);
+}
+
+TEST(ArithmeticOperationsTest, BigIntegerLehmerGcd)
+{
+    using namespace Numerics::detail;
+    using Numerics::BigInteger;
+
+    const auto euclid = [](BigInteger a, BigInteger b) {
+        a = a.abs();
+        b = b.abs();
+        while (!b.is_zero())
+            a = std::exchange(b, a % b);
+        return a;
+    };
+
+    std::mt19937_64 gen(2718);
+    const auto random = [&gen](size_t limbs) {
+        std::vector<uint64_t> value(limbs);
+        for (auto& limb : value)
+            limb = gen() % 4 == 0 ? ~uint64_t(0) : gen();
+        return BigInteger::from_limbs(value);
+    };
+
+    for (int i = 0; i < 300; ++i)
+    {
+        const BigInteger common = random(gen() % 3) + 1;
+        BigInteger a = random(gen() % 40) * common;
+        const BigInteger b = (i % 4 == 0 ? a * random(1) : random(gen() % 40)) * common;
+        if (i % 3 == 0)
+            a.negate();
+
+        const BigInteger g = euclid(a, b);
+        EXPECT_EQ(ArithmeticOperations::gcd(a, b), g);
+
+        const auto [d, x, y] = ArithmeticOperations::extended_gcd(a, b);
+        EXPECT_EQ(d, g);
+        EXPECT_EQ(a * x + b * y, d);
+    }
+
+    // Consecutive Fibonacci numbers need the longest run of unit quotients.
+    BigInteger f0 = 0;
+    BigInteger f1 = 1;
+    for (int i = 0; i < 2000; ++i)
+        f0 = std::exchange(f1, f0 + f1);
+    const auto [d, x, y] = ArithmeticOperations::extended_gcd(f1, f0);
+    EXPECT_EQ(d, BigInteger(1));
+    EXPECT_EQ(f1 * x + f0 * y, BigInteger(1));
+
+    EXPECT_EQ(std::get<0>(ArithmeticOperations::extended_gcd(BigInteger(0), BigInteger(0))),
+              BigInteger(0));
+    EXPECT_EQ(ArithmeticOperations::gcd(BigInteger(-12), BigInteger(0)), BigInteger(12));
+}
+
+TEST(ArithmeticOperationsTest, BigIntegerModularInverse)
+{
+    using namespace Numerics::detail;
+    using Numerics::BigInteger;
+
+    const BigInteger p = (BigInteger(1) << 521) - 1;
+    for (const BigInteger& a : {BigInteger(2), BigInteger(-3), (BigInteger(1) << 600) + 7, p - 1})
+    {
+        const BigInteger inverse = ArithmeticOperations::modular_inverse(a, p);
+        EXPECT_FALSE(inverse.is_negative());
+        EXPECT_LT(inverse, p);
+        EXPECT_EQ((a * inverse % p + p) % p, BigInteger(1));
+    }
+
+    // Quotients wider than two limbs take the full-division path.
+    const BigInteger wide = (BigInteger(1) << 4000) + 1;
+    EXPECT_EQ(ArithmeticOperations::modular_inverse(BigInteger(3), wide) * 3 % wide,
+              BigInteger(1));
+
+    EXPECT_EQ(ArithmeticOperations::modular_inverse(BigInteger(6), BigInteger(1) << 100),
+              BigInteger(0));
+    EXPECT_EQ(ArithmeticOperations::modular_inverse(BigInteger(5), BigInteger(1)), BigInteger(0));
+    EXPECT_THROW(ArithmeticOperations::modular_inverse(BigInteger(5), BigInteger(0)),
+                 std::domain_error);
+}
+
+TEST(ArithmeticOperationsTest, BigIntegerHalfGcd)
+{
+    using namespace Numerics::detail;
+    using Numerics::BigInteger;
+
+    std::mt19937_64 gen(1414);
+    const auto random = [&gen](size_t limbs) {
+        std::vector<uint64_t> value(limbs);
+        for (auto& limb : value)
+            limb = gen();
+        value.back() |= uint64_t(1) << 63;
+        return BigInteger::from_limbs(value);
+    };
+
+    // A common divisor of both operands that divides a * x + b * y is their gcd.
+    const auto check = [](const BigInteger& a, const BigInteger& b, const BigInteger& common) {
+        const auto [g, x, y] = ArithmeticOperations::extended_gcd(a, b);
+        EXPECT_EQ(a * x + b * y, g);
+        EXPECT_TRUE((a % g).is_zero());
+        EXPECT_TRUE((b % g).is_zero());
+        EXPECT_TRUE((g % common).is_zero());
+        EXPECT_EQ(ArithmeticOperations::gcd(a, b), g);
+    };
+
+    const size_t n = 3 * GcdThresholds::HALF_GCD;
+    const BigInteger common = random(40);
+    check(random(n) * common, random(n - 1) * common, common);
+    check(random(n) * common, -random(n / 3) * common, common);
+
+    const BigInteger a = random(n);
+    check(a, a, a);
+    check(a * random(5), a, a);
+
+    BigInteger f0 = 0;
+    BigInteger f1 = 1;
+    while (f1.limb_count() < GcdThresholds::HALF_GCD + 100)
+        f0 = std::exchange(f1, f0 + f1);
+    check(f1, f0, BigInteger(1));
+
+    const BigInteger m = random(n) + 1;
+    const BigInteger inverse = ArithmeticOperations::modular_inverse(a, m);
+    if (!inverse.is_zero())
+    {
+        EXPECT_LT(inverse, m);
+        EXPECT_EQ(a * inverse % m, BigInteger(1));
+    }
+    else
+    {
+        EXPECT_NE(ArithmeticOperations::gcd(a, m), BigInteger(1));
+    }
+}
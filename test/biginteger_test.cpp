@@ -1,4 +1,5 @@
 #include <algorithm>
+#include <array>
 #include <biginteger/biginteger.hpp>
 #include <gtest/gtest.h>
 #include <limits>
@@ -241,6 +242,64 @@ TEST_F(StringConversionTest, FromStringBaseMixed)
     EXPECT_EQ(StringConversion::from_string_base("1111", 2), expected4);
 }
 
+TEST_F(StringConversionTest, FromStringBaseLongDecimal)
+{
+    using namespace Numerics::detail;
+
+    // Digits regroup into base 10^9 elements from the right.
+    const std::string digits = "12" + std::string(27, '0') + "345678901";
+    const std::vector<uint32_t> expected = {12, 0, 0, 0, 345678901};
+    EXPECT_EQ(StringConversion::from_string_base(digits, 10), expected);
+    EXPECT_EQ(StringConversion::from_string_base("000" + digits, 10), expected);
+
+    std::vector<uint32_t> nines(11112, 999999999);
+    nines[0] = 9;
+    EXPECT_EQ(StringConversion::from_string_base(std::string(100000, '9'), 10), nines);
+    EXPECT_THROW(StringConversion::from_string_base(digits + "b", 10), std::invalid_argument);
+
+    uint64_t value = 0;
+    EXPECT_TRUE(StringConversion::read_decimal("9999999999999999999", 19, value));
+    EXPECT_EQ(value, 9999999999999999999ULL);
+    EXPECT_TRUE(StringConversion::read_decimal("0123456789012345678", 19, value));
+    EXPECT_EQ(value, 123456789012345678ULL);
+    for (char bad : {'/', ':', 'a', ' ', '\x80'})
+    {
+        std::string chunk = "1234567890123456789";
+        for (size_t i = 0; i < chunk.size(); i += 6)
+        {
+            chunk[i] = bad;
+            EXPECT_FALSE(StringConversion::read_decimal(chunk.data(), chunk.size(), value));
+            chunk[i] = '5';
+        }
+    }
+}
+
+TEST_F(StringConversionTest, PowerOfTwoBasesRoundTrip)
+{
+    using namespace Numerics::detail;
+
+    EXPECT_EQ(StringConversion::to_string_base({1, 0}, false, 8), "07346545000");
+    EXPECT_EQ(StringConversion::to_string_base({1, 0, 5}, true, 8), "-067405553164731000005");
+    EXPECT_EQ(StringConversion::from_string_base("067405553164731000005", 8),
+              (std::vector<uint32_t>{1, 0, 5}));
+    EXPECT_EQ(StringConversion::from_string_base("0b0000", 2), std::vector<uint32_t>{0});
+
+    std::mt19937 gen(17);
+    for (size_t size : {1, 2, 9, 40, 200})
+    {
+        std::vector<uint32_t> digits(size);
+        for (auto& digit : digits)
+            digit = gen() % NumericConstants::BASE;
+        digits[0] = digits[0] % 1000 + 1;
+
+        for (int base : {2, 4, 8})
+        {
+            std::string text = StringConversion::to_string_base(digits, false, base);
+            EXPECT_EQ(StringConversion::from_string_base(text, base), digits) << "base=" << base;
+        }
+    }
+}
+
 TEST_F(StringConversionTest, DISABLED_PerformanceTest)
 {
     using namespace Numerics::detail;
@@ -263,6 +322,353 @@ TEST_F(StringConversionTest, DISABLED_PerformanceTest)
     SUCCEED();
 }
 
+class BigIntegerTest : public ::testing::Test
+{
+protected:
+    using BigInteger = Numerics::BigInteger;
+
+    BigInteger randomValue(std::mt19937_64& gen, size_t max_limbs)
+    {
+        std::vector<uint64_t> limbs(gen() % (max_limbs + 1));
+        for (auto& limb : limbs)
+        {
+            // Mix in saturated and sparse limbs so carries and quotient corrections get exercised.
+            switch (gen() % 4)
+            {
+            case 0:
+                limb = ~uint64_t(0);
+                break;
+            case 1:
+                limb = 0;
+                break;
+            case 2:
+                limb = uint64_t(1) << 63;
+                break;
+            default:
+                limb = gen();
+            }
+        }
+        return BigInteger::from_limbs(limbs, gen() & 1);
+    }
+};
+
+TEST_F(BigIntegerTest, ConstructsFromIntegers)
+{
+    EXPECT_TRUE(BigInteger().is_zero());
+    EXPECT_EQ(BigInteger(0).sign(), 0);
+    EXPECT_EQ(BigInteger(42).to_string(), "42");
+    EXPECT_EQ(BigInteger(-42).to_string(), "-42");
+    EXPECT_EQ(BigInteger(std::numeric_limits<int64_t>::min()).to_string(),
+              "-9223372036854775808");
+    EXPECT_EQ(BigInteger(std::numeric_limits<uint64_t>::max()).to_string(),
+              "18446744073709551615");
+
+    EXPECT_EQ(static_cast<int64_t>(BigInteger(-12345)), -12345);
+    EXPECT_EQ(static_cast<uint32_t>(BigInteger(0x1234567890ULL)), 0x34567890U);
+    EXPECT_EQ(BigInteger(-1).limb_count(), 1U);
+}
+
+TEST_F(BigIntegerTest, StringRoundTrip)
+{
+    const std::string decimal = "-123456789012345678901234567890123456789";
+    EXPECT_EQ(BigInteger(decimal).to_string(), decimal);
+    EXPECT_EQ(BigInteger("+000123").to_string(), "123");
+    EXPECT_EQ(BigInteger("18446744073709551616").limb_count(), 2U);
+
+    const BigInteger all_ones = (BigInteger(1) << 200) - 1;
+    EXPECT_EQ(all_ones.to_string(),
+              "1606938044258990275541962092341162602522202993782792835301375");
+    EXPECT_EQ(all_ones.to_string(16), std::string(50, 'F'));
+    EXPECT_EQ(BigInteger("0x" + std::string(50, 'f'), 16), all_ones);
+    EXPECT_EQ(BigInteger("-0b101", 2), BigInteger(-5));
+    EXPECT_EQ(BigInteger("zz", 36), BigInteger(35 * 36 + 35));
+
+    EXPECT_THROW(BigInteger(""), std::invalid_argument);
+    EXPECT_THROW(BigInteger("-"), std::invalid_argument);
+    EXPECT_THROW(BigInteger("12a4"), std::invalid_argument);
+    EXPECT_THROW(BigInteger("777", 1), std::out_of_range);
+}
+
+TEST_F(BigIntegerTest, CharsConversion)
+{
+    using memory = Numerics::detail::MemoryManager<uint64_t>;
+    using Numerics::detail::RadixConversion;
+
+    std::mt19937_64 gen(5);
+    std::vector<uint64_t> words(20);
+    for (auto& word : words)
+        word = gen();
+    const BigInteger value = -BigInteger::from_limbs(words);
+
+    for (int radix : {2, 8, 10, 16, 36})
+    {
+        const std::string expected = value.to_string(radix);
+        std::vector<char> buffer(value.max_chars(radix));
+        ASSERT_GE(buffer.size(), expected.size());
+
+        // Once the target has room, neither direction touches the heap.
+        BigInteger parsed = value * 3;
+        memory::reset_allocation_counters();
+        const auto written = to_chars(buffer.data(), buffer.data() + buffer.size(), value, radix);
+        const auto read = from_chars(buffer.data(), written.ptr, parsed, radix);
+        EXPECT_EQ(memory::allocation_counters().allocations, 0U) << "radix=" << radix;
+
+        ASSERT_EQ(written.ec, std::errc{});
+        EXPECT_EQ(std::string(buffer.data(), written.ptr), expected);
+        EXPECT_EQ(read.ec, std::errc{});
+        EXPECT_EQ(read.ptr, written.ptr);
+        EXPECT_EQ(parsed, value);
+
+        const auto short_write =
+            to_chars(buffer.data(), buffer.data() + expected.size() - 1, value, radix);
+        EXPECT_EQ(short_write.ec, std::errc::value_too_large);
+        EXPECT_EQ(short_write.ptr, buffer.data() + expected.size() - 1);
+    }
+
+    // Parsing stops at the first character that is not a digit of the base.
+    const std::string text = "-12ab9z";
+    BigInteger parsed;
+    auto read = from_chars(text.data(), text.data() + text.size(), parsed, 12);
+    EXPECT_EQ(read.ptr, text.data() + 6);
+    EXPECT_EQ(parsed, BigInteger(-((((1 * 12 + 2) * 12 + 10) * 12 + 11) * 12 + 9)));
+
+    read = from_chars(text.data(), text.data() + 1, parsed, 10);
+    EXPECT_EQ(read.ec, std::errc::invalid_argument);
+    EXPECT_EQ(read.ptr, text.data());
+    EXPECT_EQ(parsed, BigInteger(-25773));
+
+    const std::string zero = "-000";
+    EXPECT_EQ(from_chars(zero.data(), zero.data() + zero.size(), parsed).ec, std::errc{});
+    EXPECT_TRUE(parsed.is_zero());
+    EXPECT_FALSE(parsed.is_negative());
+
+    // Limb spans hold magnitudes and report values that do not fit.
+    const std::string digits = (BigInteger(1) << 128).to_string();
+    std::array<uint64_t, 3> limbs{7, 7, 7};
+    EXPECT_EQ(RadixConversion::from_chars(digits.data(), digits.data() + digits.size(), limbs, 10)
+                  .ec,
+              std::errc{});
+    EXPECT_EQ(limbs, (std::array<uint64_t, 3>{0, 0, 1}));
+    EXPECT_EQ(RadixConversion::from_chars(digits.data(), digits.data() + digits.size(),
+                                          std::span(limbs).first(2), 10)
+                  .ec,
+              std::errc::result_out_of_range);
+
+    std::array<char, 40> chars{};
+    const auto written = RadixConversion::to_chars(chars.data(), chars.data() + chars.size(),
+                                                   limbs, 10);
+    EXPECT_EQ(std::string(chars.data(), written.ptr), digits);
+    EXPECT_EQ(RadixConversion::max_chars(limbs, 10), digits.size());
+    EXPECT_EQ(RadixConversion::max_chars(std::span<const uint64_t>(), 10), 1U);
+}
+
+TEST_F(BigIntegerTest, PowerOfTwoBasesReadBitGroups)
+{
+    std::mt19937_64 gen(21);
+    for (size_t limbs : {size_t(1), size_t(3), size_t(64), size_t(700)})
+    {
+        std::vector<uint64_t> words(limbs);
+        for (auto& word : words)
+            word = gen() % 4 == 0 ? ~uint64_t(0) : gen();
+        const BigInteger value = BigInteger::from_limbs(words);
+
+        std::string binary;
+        for (size_t bit = value.bit_length(); bit-- > 0;)
+            binary += value.test_bit(bit) ? '1' : '0';
+        EXPECT_EQ(value.to_string(2), binary);
+
+        // Every digit of base 2^bits is a group of bits, counted from the least significant,
+        // so groups straddle limbs whenever bits does not divide 64.
+        for (int bits = 2; bits <= 5; ++bits)
+        {
+            const std::string padded =
+                std::string((bits - binary.size() % bits) % bits, '0') + binary;
+            std::string expected;
+            for (size_t i = 0; i < padded.size(); i += bits)
+                expected += "0123456789ABCDEFGHIJKLMNOPQRSTUV"[std::stoi(padded.substr(i, bits),
+                                                                         nullptr, 2)];
+
+            const int radix = 1 << bits;
+            EXPECT_EQ(value.to_string(radix), expected) << "radix=" << radix;
+            EXPECT_EQ(BigInteger(expected, radix), value) << "radix=" << radix;
+            EXPECT_EQ(-BigInteger("-" + expected, radix), value) << "radix=" << radix;
+        }
+    }
+    EXPECT_EQ(BigInteger("0000000000000000000000000000000000000000001", 8), BigInteger(1));
+}
+
+TEST_F(BigIntegerTest, LargeStringsParse)
+{
+    using Numerics::detail::ConversionThresholds;
+
+    for (size_t digits : {size_t(19), size_t(20), size_t(2000), size_t(54321)})
+    {
+        const BigInteger power = BigInteger(10).pow(digits);
+        EXPECT_EQ(BigInteger("1" + std::string(digits, '0')), power);
+        EXPECT_EQ(BigInteger(std::string(digits, '9')), power - 1);
+        EXPECT_EQ(BigInteger("-" + std::string(digits, '0') + "1"), BigInteger(-1));
+    }
+    EXPECT_EQ(BigInteger("1" + std::string(3000, '0'), 3), BigInteger(3).pow(3000));
+    EXPECT_EQ(BigInteger(std::string(4000, 'z'), 36), BigInteger(36).pow(4000) - 1);
+
+    std::mt19937_64 gen(7);
+    const size_t long_size = 20 * ConversionThresholds::FROM_STRING * 19;
+    for (uint32_t radix : {2U, 7U, 10U, 16U, 36U})
+    {
+        std::string digits(long_size, '0');
+        for (auto& c : digits)
+            c = "0123456789abcdefghijklmnopqrstuvwxyz"[gen() % radix];
+        digits[0] = '1';
+
+        const BigInteger value(digits, static_cast<int>(radix));
+        std::string lower = value.to_string(static_cast<int>(radix));
+        std::transform(lower.begin(), lower.end(), lower.begin(),
+                       [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        EXPECT_EQ(lower, digits) << "radix=" << radix;
+
+        digits[digits.size() / 3] = '#';
+        EXPECT_THROW(BigInteger(digits, static_cast<int>(radix)), std::invalid_argument);
+    }
+}
+
+TEST_F(BigIntegerTest, LargeValuesConvertToStrings)
+{
+    using Numerics::detail::ConversionThresholds;
+
+    // Powers of the radix and their predecessors keep runs of zero and maximal digits across
+    // every split point of the divide-and-conquer conversion.
+    for (size_t digits : {size_t(1), size_t(19), size_t(400), size_t(3000), size_t(12345)})
+    {
+        const BigInteger power = BigInteger(10).pow(digits);
+        EXPECT_EQ(power.to_string(), "1" + std::string(digits, '0'));
+        EXPECT_EQ((power - 1).to_string(), std::string(digits, '9'));
+        EXPECT_EQ((1 - power).to_string(), "-" + std::string(digits, '9'));
+    }
+    EXPECT_EQ(BigInteger(7).pow(5000).to_string(7), "1" + std::string(5000, '0'));
+    EXPECT_EQ((BigInteger(36).pow(2000) - 1).to_string(36), std::string(2000, 'Z'));
+
+    std::mt19937_64 gen(99);
+    for (size_t limbs : {ConversionThresholds::TO_STRING, size_t(257), size_t(1000)})
+    {
+        std::vector<uint64_t> words(limbs);
+        for (auto& word : words)
+            word = gen() % 5 == 0 ? 0 : gen();
+        const BigInteger value = BigInteger::from_limbs(words);
+
+        for (uint32_t radix : {2U, 3U, 10U, 16U, 36U})
+            EXPECT_EQ(BigInteger(value.to_string(radix), radix), value) << "radix=" << radix;
+    }
+}
+
+TEST_F(BigIntegerTest, AdditionAndSubtraction)
+{
+    const BigInteger a("123456789012345678901234567890123456789");
+    const BigInteger b("-987654321098765432109876543210");
+
+    EXPECT_EQ((a + b).to_string(), "123456788024691357802469135780246913579");
+    EXPECT_EQ((a - b).to_string(), "123456789999999999999999999999999999999");
+    EXPECT_EQ(b - a, -(a - b));
+    EXPECT_TRUE((a - a).is_zero());
+    EXPECT_FALSE((b - b).is_negative());
+
+    BigInteger carry(std::numeric_limits<uint64_t>::max());
+    ++carry;
+    EXPECT_EQ(carry, BigInteger(1) << 64);
+    --carry;
+    EXPECT_EQ(carry, BigInteger(std::numeric_limits<uint64_t>::max()));
+
+    BigInteger self = a;
+    self += self;
+    EXPECT_EQ(self, a * 2);
+    self -= self;
+    EXPECT_TRUE(self.is_zero());
+}
+
+TEST_F(BigIntegerTest, Multiplication)
+{
+    const BigInteger a("123456789012345678901234567890123456789");
+    const BigInteger b("-987654321098765432109876543210");
+
+    EXPECT_EQ((a * b).to_string(),
+              "-121932631137021795226185032733744855963362292333223746380111126352690");
+    EXPECT_EQ(b * b, (-b) * (-b));
+    EXPECT_TRUE((a * 0).is_zero());
+    EXPECT_FALSE((b * 0).is_negative());
+
+    const BigInteger max64(std::numeric_limits<uint64_t>::max());
+    EXPECT_EQ(max64 * max64, (BigInteger(1) << 128) - (BigInteger(1) << 65) + 1);
+}
+
+TEST_F(BigIntegerTest, DivisionTruncatesTowardZero)
+{
+    EXPECT_EQ(BigInteger(7) / BigInteger(2), BigInteger(3));
+    EXPECT_EQ(BigInteger(-7) / BigInteger(2), BigInteger(-3));
+    EXPECT_EQ(BigInteger(-7) % BigInteger(2), BigInteger(-1));
+    EXPECT_EQ(BigInteger(7) % BigInteger(-2), BigInteger(1));
+
+    const BigInteger a("123456789012345678901234567890123456789");
+    const BigInteger b("-987654321098765432109876543210");
+    EXPECT_EQ((a / b).to_string(), "-124999998");
+    EXPECT_EQ((a % b).to_string(), "850308642085030864208626543209");
+
+    EXPECT_THROW(a / BigInteger(), std::domain_error);
+    EXPECT_THROW(a % BigInteger(), std::domain_error);
+}
+
+TEST_F(BigIntegerTest, DivisionIdentityHoldsForRandomOperands)
+{
+    std::mt19937_64 gen(20240501);
+
+    for (int i = 0; i < 2000; ++i)
+    {
+        const BigInteger a = randomValue(gen, 12);
+        const BigInteger b = randomValue(gen, 6);
+        if (b.is_zero())
+            continue;
+
+        const BigInteger q = a / b;
+        const BigInteger r = a % b;
+
+        EXPECT_EQ(q * b + r, a);
+        EXPECT_LT(r.abs(), b.abs());
+        EXPECT_TRUE(r.is_zero() || r.is_negative() == a.is_negative());
+    }
+}
+
+TEST_F(BigIntegerTest, Shifts)
+{
+    const BigInteger one(1);
+    EXPECT_EQ((one << 64).limb_count(), 2U);
+    EXPECT_EQ((one << 200) >> 200, one);
+    EXPECT_EQ((one << 130).bit_length(), 131U);
+
+    const BigInteger a("123456789012345678901234567890123456789");
+    EXPECT_EQ((a << 100).to_string(),
+              "156500072693749876333549759455083473609492697353681459748461728497664");
+    EXPECT_EQ((a >> 64) << 64, a - (a % (one << 64)));
+
+    // Negative values shift like two's complement integers.
+    EXPECT_EQ(BigInteger(-5) >> 1, BigInteger(-3));
+    EXPECT_EQ(BigInteger(-4) >> 1, BigInteger(-2));
+    EXPECT_EQ(BigInteger(-1) >> 500, BigInteger(-1));
+    EXPECT_EQ(BigInteger("-987654321098765432109876543210") >> 70, BigInteger(-836575751));
+}
+
+TEST_F(BigIntegerTest, Comparison)
+{
+    const BigInteger small(-5);
+    const BigInteger large("100000000000000000000000");
+
+    EXPECT_LT(small, BigInteger(0));
+    EXPECT_LT(BigInteger(0), large);
+    EXPECT_LT(-large, small);
+    EXPECT_GT(large, BigInteger(std::numeric_limits<uint64_t>::max()));
+    EXPECT_EQ(large, BigInteger("100000000000000000000000"));
+    EXPECT_NE(large, -large);
+    EXPECT_TRUE(small == -5);
+    EXPECT_TRUE(large > 1);
+}
+
 // TEST_F(StringConversionTest, EdgeCases)
 // {
 //     using namespace Numerics::detail;
@@ -0,0 +1,88 @@
+#include <biginteger/biginteger.hpp>
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+using namespace Numerics::detail;
+
+class DivisionTest : public ::testing::Test
+{
+protected:
+    std::mt19937_64 gen{2024};
+
+    std::vector<uint64_t> randomLimbs(size_t n)
+    {
+        std::vector<uint64_t> limbs(n);
+        const auto mode = gen() % 3;
+        for (auto& limb : limbs)
+        {
+            if (mode == 0)
+                limb = ~uint64_t(0);
+            else if (mode == 1)
+                limb = gen();
+            else
+                limb = (gen() % 4 == 0) ? 0 : gen();
+        }
+        if (limbs.back() == 0)
+            limbs.back() = 1;
+        return limbs;
+    }
+
+    void checkAgainstKnuth(const std::vector<uint64_t>& a, const std::vector<uint64_t>& b)
+    {
+        const size_t an = a.size();
+        const size_t bn = b.size();
+        std::vector<uint64_t> q(an - bn + 1), r(bn), expected_q(an - bn + 1), expected_r(bn);
+
+        Division::divrem(q.data(), r.data(), a.data(), an, b.data(), bn);
+        LimbArithmetic::divrem(expected_q.data(), expected_r.data(), a.data(), an, b.data(), bn);
+        EXPECT_EQ(q, expected_q) << "an=" << an << " bn=" << bn;
+        EXPECT_EQ(r, expected_r) << "an=" << an << " bn=" << bn;
+    }
+};
+
+TEST_F(DivisionTest, MatchesAlgorithmD)
+{
+    const size_t sizes[][2] = {{60, 50},   {120, 60},  {121, 60},  {200, 49},  {300, 97},
+                               {513, 256}, {700, 300}, {1000, 999}, {1500, 400}};
+
+    for (const auto& size : sizes)
+        checkAgainstKnuth(randomLimbs(size[0]), randomLimbs(size[1]));
+}
+
+TEST_F(DivisionTest, HandlesNormalizedAndNearMultipleDividends)
+{
+    for (size_t bn : {48, 75, 128, 333})
+    {
+        auto b = randomLimbs(bn);
+        b.back() |= uint64_t(1) << 63;
+        const auto q = randomLimbs(bn + 17);
+
+        // a = q * b - 1 forces the largest quotient estimate corrections.
+        std::vector<uint64_t> a(q.size() + bn);
+        Multiplication::multiply(a.data(), q.data(), q.size(), b.data(), bn);
+        LimbArithmetic::sub_1(a.data(), a.data(), a.size(), 1);
+        a.resize(LimbArithmetic::normalized_size(a.data(), a.size()));
+
+        checkAgainstKnuth(a, b);
+    }
+}
+
+TEST_F(DivisionTest, BigIntegerDivremReturnsBoth)
+{
+    using Numerics::BigInteger;
+
+    const BigInteger a = (BigInteger(1) << 50000) - BigInteger("987654321987654321987654321");
+    const BigInteger b = (BigInteger(5) << 20000) + 12345;
+    const auto [quotient, remainder] = a.divrem(b);
+
+    EXPECT_EQ(quotient * b + remainder, a);
+    EXPECT_LT(remainder, b);
+    EXPECT_GE(remainder, BigInteger(0));
+
+    const auto [negative_quotient, negative_remainder] = (-a).divrem(b);
+    EXPECT_EQ(negative_quotient, -quotient);
+    EXPECT_EQ(negative_remainder, -remainder);
+
+    EXPECT_THROW((void)a.divrem(BigInteger(0)), std::domain_error);
+}
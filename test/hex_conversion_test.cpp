@@ -1,5 +1,7 @@
 #include "biginteger/hex_conversion.hpp"
 #include <gtest/gtest.h>
+#include <random>
+#include <string>
 
 // ==================================================================================================
 // TEST HEX CONVERSION CONCEPTS
@@ -447,6 +449,145 @@ TEST_F(HexConverterTest, DecodeIntegral)
         std::invalid_argument);
 }
 
+// ==================================================================================================
+// HEX BULK CONVERSION TEST
+// ==================================================================================================
+
+class HexBulkConversionTest : public ::testing::Test
+{
+protected:
+    using converter = hex::hex_converter;
+    using simd_level = hex::detail::simd_level;
+
+    // The scalar loops plus every vector level this CPU runs.
+    static std::vector<simd_level> levels()
+    {
+        std::vector<simd_level> result;
+        for (simd_level level : {simd_level::scalar, simd_level::neon, simd_level::ssse3,
+                                 simd_level::avx2, simd_level::avx512})
+        {
+            if (hex::detail::hex_kernels::supported(level) == level)
+            {
+                result.push_back(level);
+            }
+        }
+        return result;
+    }
+
+    static std::string reference_encode(const std::vector<std::byte>& bytes)
+    {
+        std::string result;
+        for (std::byte b : bytes)
+        {
+            result += "0123456789ABCDEF"[static_cast<int>(b) >> 4];
+            result += "0123456789ABCDEF"[static_cast<int>(b) & 0xF];
+        }
+        return result;
+    }
+};
+
+TEST_F(HexBulkConversionTest, RoundTripAtEveryLevel)
+{
+    std::mt19937_64 gen(25);
+    for (simd_level level : levels())
+    {
+        SCOPED_TRACE(static_cast<int>(level));
+        for (size_t n : {0, 1, 15, 16, 17, 31, 32, 33, 63, 64, 65, 127, 128, 129, 200, 1000})
+        {
+            std::vector<std::byte> bytes(n);
+            for (auto& b : bytes)
+            {
+                b = static_cast<std::byte>(gen());
+            }
+
+            std::string encoded(2 * n, '?');
+            EXPECT_EQ(converter::encode_to(bytes, encoded.data(), level), encoded.data() + 2 * n);
+            EXPECT_EQ(encoded, reference_encode(bytes)) << "n=" << n;
+
+            for (auto& c : encoded)
+            {
+                c = gen() % 2 ? static_cast<char>(std::tolower(c)) : c;
+            }
+            std::vector<std::byte> decoded(n);
+            EXPECT_EQ(converter::decode_to(encoded, decoded.data(), level), decoded.data() + n);
+            EXPECT_EQ(decoded, bytes) << "n=" << n;
+        }
+    }
+
+    const std::vector<std::byte> bytes(100, std::byte{0x5A});
+    EXPECT_EQ(converter::encode_string(bytes), reference_encode(bytes));
+    EXPECT_EQ(converter::decode<std::vector<std::byte>>(converter::encode_string(bytes)), bytes);
+}
+
+TEST_F(HexBulkConversionTest, DecodeRejectsEveryNonHexCharacter)
+{
+    const std::string valid(2 * 130, 'a');
+    std::vector<std::byte> out(valid.size() / 2);
+    for (simd_level level : levels())
+    {
+        SCOPED_TRACE(static_cast<int>(level));
+        for (int c = 0; c < 256; ++c)
+        {
+            std::string hex = valid;
+            const size_t position = (c * 37) % hex.size();
+            hex[position] = static_cast<char>(c);
+            if (std::isxdigit(c))
+            {
+                EXPECT_NO_THROW(converter::decode_to(hex, out.data(), level));
+            }
+            else
+            {
+                EXPECT_THROW(converter::decode_to(hex, out.data(), level), std::invalid_argument)
+                    << "c=" << c << " position=" << position;
+            }
+        }
+
+        for (size_t position = 0; position < valid.size(); ++position)
+        {
+            std::string hex = valid;
+            hex[position] = 'g';
+            EXPECT_THROW(converter::decode_to(hex, out.data(), level), std::invalid_argument)
+                << "position=" << position;
+        }
+    }
+
+    EXPECT_THROW(converter::decode_to("ABC", out.data()), std::invalid_argument);
+}
+
+TEST_F(HexBulkConversionTest, IteratorEncodeFillsBuffer)
+{
+    std::vector<std::byte> bytes(40);
+    for (size_t i = 0; i < bytes.size(); ++i)
+    {
+        bytes[i] = static_cast<std::byte>(i * 7);
+    }
+
+    // The buffer holds 64 digits, so only the first 32 bytes fit.
+    auto buffer = converter::encode(bytes.begin(), bytes.end());
+    EXPECT_EQ(std::string(buffer.begin(), buffer.end()),
+              reference_encode(std::vector<std::byte>(bytes.begin(), bytes.begin() + 32)));
+}
+
+TEST_F(HexBulkConversionTest, WideCharacters)
+{
+    const std::u16string hex = u"00FF7a" + std::u16string(100, u'3');
+    const auto bytes = hex::u16hex_converter::decode<std::vector<std::byte>>(hex);
+    ASSERT_EQ(bytes.size(), 53);
+    EXPECT_EQ(bytes[1], std::byte{0xFF});
+    EXPECT_EQ(bytes[2], std::byte{0x7A});
+    EXPECT_EQ(bytes[52], std::byte{0x33});
+
+    // U+0141 must not pass as 'A' through its low byte.
+    EXPECT_THROW(
+        { auto result = hex::u16hex_converter::decode<std::vector<std::byte>>(u"\u0141B"); },
+        std::invalid_argument);
+
+    std::u32string encoded(4, U'?');
+    hex::u32hex_converter::encode_to(std::vector<std::byte>{std::byte{0xC0}, std::byte{0x1D}},
+                                     encoded.data());
+    EXPECT_EQ(encoded, U"C01D");
+}
+
 // ==================================================================================================
 // HEX LITERAL TEST
 // ==================================================================================================
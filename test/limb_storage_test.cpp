@@ -0,0 +1,218 @@
+#include <atomic>
+#include <biginteger/biginteger.hpp>
+#include <cstddef>
+#include <cstdlib>
+#include <gtest/gtest.h>
+#include <new>
+
+namespace
+{
+
+std::atomic<size_t> global_new_calls{0};
+
+// Every replaced allocation form below goes through here, so none escapes the count.
+void* counted_allocate(size_t size, size_t alignment)
+{
+    global_new_calls.fetch_add(1, std::memory_order_relaxed);
+    size = size ? size : 1;
+    void* ptr = alignment <= alignof(std::max_align_t)
+                    ? std::malloc(size)
+                    : std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+    if (!ptr)
+        throw std::bad_alloc();
+    return ptr;
+}
+
+void counted_deallocate(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+} // namespace
+
+// Count every global allocation so the tests below can prove that small-value arithmetic stays
+// entirely off the heap, not just off MemoryManager.
+void* operator new(size_t size)
+{
+    return counted_allocate(size, alignof(std::max_align_t));
+}
+
+void* operator new[](size_t size)
+{
+    return counted_allocate(size, alignof(std::max_align_t));
+}
+
+void* operator new(size_t size, std::align_val_t alignment)
+{
+    return counted_allocate(size, static_cast<size_t>(alignment));
+}
+
+void* operator new[](size_t size, std::align_val_t alignment)
+{
+    return counted_allocate(size, static_cast<size_t>(alignment));
+}
+
+void operator delete(void* ptr) noexcept
+{
+    counted_deallocate(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    counted_deallocate(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+    counted_deallocate(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept
+{
+    counted_deallocate(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept
+{
+    counted_deallocate(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t) noexcept
+{
+    counted_deallocate(ptr);
+}
+
+void operator delete(void* ptr, size_t, std::align_val_t) noexcept
+{
+    counted_deallocate(ptr);
+}
+
+void operator delete[](void* ptr, size_t, std::align_val_t) noexcept
+{
+    counted_deallocate(ptr);
+}
+
+using namespace Numerics::detail;
+
+class LimbStorageTest : public ::testing::Test
+{
+protected:
+    using memory = MemoryManager<uint64_t>;
+
+    void SetUp() override { memory::reset_allocation_counters(); }
+};
+
+TEST_F(LimbStorageTest, StaysInlineUpToCapacity)
+{
+    LimbStorage<4> storage;
+    EXPECT_TRUE(storage.is_inline());
+    EXPECT_EQ(storage.capacity(), 4U);
+
+    storage.resize(4);
+    storage[3] = 42;
+    EXPECT_TRUE(storage.is_inline());
+    EXPECT_EQ(memory::allocation_counters().allocations, 0U);
+
+    storage.push_back(7);
+    EXPECT_FALSE(storage.is_inline());
+    EXPECT_EQ(storage.size(), 5U);
+    EXPECT_EQ(storage[3], 42U);
+    EXPECT_EQ(storage[4], 7U);
+    EXPECT_EQ(memory::allocation_counters().allocations, 1U);
+}
+
+TEST_F(LimbStorageTest, HeapStorageIsAligned)
+{
+    LimbStorage<2> storage;
+    storage.resize(100);
+
+    const auto address = reinterpret_cast<uintptr_t>(storage.data());
+    EXPECT_EQ(address % memory::ALIGNMENT, 0U);
+    EXPECT_TRUE(
+        std::all_of(storage.begin(), storage.end(), [](uint64_t limb) { return limb == 0; }));
+}
+
+TEST_F(LimbStorageTest, MoveStealsHeapBuffer)
+{
+    LimbStorage<2> source;
+    source.resize(10);
+    source[9] = 99;
+    const auto* buffer = source.data();
+
+    LimbStorage<2> target(std::move(source));
+    EXPECT_EQ(target.data(), buffer);
+    EXPECT_EQ(target[9], 99U);
+    EXPECT_TRUE(source.empty());
+    EXPECT_TRUE(source.is_inline());
+
+    LimbStorage<2> copy = target;
+    EXPECT_NE(copy.data(), target.data());
+    EXPECT_EQ(copy, target);
+}
+
+TEST_F(LimbStorageTest, ReleasesEveryAllocation)
+{
+    {
+        LimbStorage<1> a;
+        a.resize(50);
+        LimbStorage<1> b = a;
+        b.resize(500);
+        a = std::move(b);
+    }
+
+    const auto counters = memory::allocation_counters();
+    EXPECT_GT(counters.allocations, 0U);
+    EXPECT_EQ(counters.allocations, counters.deallocations);
+}
+
+TEST_F(LimbStorageTest, SmallValueArithmeticDoesNotAllocate)
+{
+    using Numerics::BigInteger;
+
+    const BigInteger a(std::numeric_limits<uint64_t>::max());
+    const BigInteger b(-123456789);
+    const BigInteger wide = (a << 64) + a;
+
+    const size_t global_before = global_new_calls.load();
+    BigInteger acc;
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        BigInteger x = wide + b;
+        x -= a;
+        x = x * b;
+        x = (x / a) % wide;
+        x <<= 63;
+        x >>= 17;
+        acc += x;
+        acc = acc % wide;
+    }
+
+    EXPECT_EQ(global_new_calls.load(), global_before);
+    EXPECT_LT(acc.abs(), wide);
+    EXPECT_EQ(memory::allocation_counters().allocations, 0U);
+}
+
+TEST_F(LimbStorageTest, LargeValuesUseMemoryManager)
+{
+    using Numerics::BigInteger;
+
+    {
+        const BigInteger big = BigInteger(1) << 1000;
+        EXPECT_EQ(big.bit_length(), 1001U);
+        EXPECT_GT(memory::allocation_counters().allocations, 0U);
+    }
+
+    const auto counters = memory::allocation_counters();
+    EXPECT_EQ(counters.allocations, counters.deallocations);
+}
+
+TEST_F(LimbStorageTest, InlineCapacityIsConfigurable)
+{
+    using Wide = Numerics::BasicBigInteger<8>;
+
+    const Wide x = (Wide(1) << 250) - 1;
+    const Wide y = x * x;
+    EXPECT_EQ(y.limb_count(), 8U);
+    EXPECT_EQ(memory::allocation_counters().allocations, 0U);
+}
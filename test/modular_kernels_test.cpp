@@ -0,0 +1,203 @@
+#include <biginteger/biginteger.hpp>
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+using Numerics::BigInteger;
+using Numerics::detail::ArithmeticOperations;
+using Numerics::detail::CpuFeatures;
+using Numerics::detail::ModularKernels;
+using Numerics::detail::SimdLevel;
+
+namespace
+{
+
+std::vector<SimdLevel> vectorLevels()
+{
+    std::vector<SimdLevel> levels;
+    for (SimdLevel level : {SimdLevel::Neon, SimdLevel::Avx2, SimdLevel::Avx512})
+    {
+        if (CpuFeatures::supported(level) == level)
+            levels.push_back(level);
+    }
+    return levels;
+}
+
+template <typename T>
+std::vector<T> randomResidues(std::mt19937_64& gen, size_t n, T m)
+{
+    std::vector<T> values(n);
+    for (auto& x : values)
+    {
+        const auto mode = gen() % 8;
+        x = mode == 0 ? m - 1 : mode == 1 ? 0 : static_cast<T>(gen() % m);
+    }
+    return values;
+}
+
+// Odd, even, near-full-range and Shoup-boundary moduli.
+template <typename T>
+std::vector<T> testModuli(std::mt19937_64& gen)
+{
+    constexpr T TOP = T(1) << (std::numeric_limits<T>::digits - 1);
+    std::vector<T> moduli = {1, 2, 3, TOP - 1, TOP, TOP + 1, T(~T(0)), T(~T(0) - 1)};
+    for (int i = 0; i < 20; ++i)
+        moduli.push_back(static_cast<T>(gen() >> (gen() % 48)) | 1);
+    moduli.push_back(static_cast<T>(gen()) & ~T(1));
+    return moduli;
+}
+
+template <typename T>
+void expectKernelsMatchReference(std::mt19937_64& gen, SimdLevel level)
+{
+    for (T m : testModuli<T>(gen))
+    {
+        for (size_t n : {0, 1, 7, 8, 17, 64, 133})
+        {
+            const auto a = randomResidues<T>(gen, n, m);
+            const auto b = randomResidues<T>(gen, n, m);
+            std::vector<T> expected(n);
+            std::vector<T> actual(n);
+            const auto check = [&](const char* kernel) {
+                EXPECT_EQ(actual, expected) << kernel << " m=" << m << " n=" << n;
+            };
+
+            ModularKernels::mod_add(expected, a, b, m, SimdLevel::Scalar);
+            ModularKernels::mod_add(actual, a, b, m, level);
+            check("mod_add");
+
+            ModularKernels::mod_sub(expected, a, b, m, SimdLevel::Scalar);
+            ModularKernels::mod_sub(actual, a, b, m, level);
+            check("mod_sub");
+
+            ModularKernels::mod_mul(expected, a, b, m, SimdLevel::Scalar);
+            ModularKernels::mod_mul(actual, a, b, m, level);
+            check("mod_mul");
+
+            const T w = static_cast<T>(gen() % m);
+            ModularKernels::mod_mul(expected, a, w, m, SimdLevel::Scalar);
+            ModularKernels::mod_mul(actual, a, w, m, level);
+            check("mod_mul by scalar");
+
+            for (uint64_t exponent : {uint64_t(0), uint64_t(1), uint64_t(m - 1), gen()})
+            {
+                ModularKernels::mod_pow_batch(expected, a, exponent, m, SimdLevel::Scalar);
+                ModularKernels::mod_pow_batch(actual, a, exponent, m, level);
+                check("mod_pow_batch");
+            }
+
+            // In place.
+            actual = a;
+            ModularKernels::mod_mul(actual, actual, b, m, level);
+            ModularKernels::mod_mul(expected, a, b, m, SimdLevel::Scalar);
+            check("in-place mod_mul");
+        }
+    }
+}
+
+template <typename T>
+void expectUnreducedScalarMultiplier(std::mt19937_64& gen, SimdLevel level)
+{
+    for (T m : testModuli<T>(gen))
+    {
+        const auto a = randomResidues<T>(gen, 37, m);
+        for (T w : {m, T(m + 1), T(~T(0)), T(gen() | m)})
+        {
+            if (w < m)
+                continue;
+            std::vector<T> expected(a.size());
+            std::vector<T> actual(a.size());
+            ModularKernels::mod_mul(expected, a, T(w % m), m, SimdLevel::Scalar);
+            ModularKernels::mod_mul(actual, a, w, m, level);
+            EXPECT_EQ(actual, expected) << "m=" << m << " w=" << w;
+        }
+    }
+}
+
+} // namespace
+
+TEST(ModularKernelsTest, ScalarReferenceMatchesBigInteger)
+{
+    std::mt19937_64 gen(31);
+    const uint64_t m = 0xFFFFFFFFFFFFFFC5ULL;
+    const auto a = randomResidues<uint64_t>(gen, 50, m);
+    const auto b = randomResidues<uint64_t>(gen, 50, m);
+    std::vector<uint64_t> sum(50), difference(50), product(50), power(50);
+
+    ModularKernels::mod_add(sum, a, b, m, SimdLevel::Scalar);
+    ModularKernels::mod_sub(difference, a, b, m, SimdLevel::Scalar);
+    ModularKernels::mod_mul(product, a, b, m, SimdLevel::Scalar);
+    ModularKernels::mod_pow_batch(power, a, 65537, m, SimdLevel::Scalar);
+
+    const BigInteger modulus(m);
+    for (size_t i = 0; i < a.size(); ++i)
+    {
+        const BigInteger x(a[i]);
+        const BigInteger y(b[i]);
+        EXPECT_EQ(BigInteger(sum[i]), (x + y) % modulus);
+        EXPECT_EQ(BigInteger(difference[i]), (x - y + modulus) % modulus);
+        EXPECT_EQ(BigInteger(product[i]), x * y % modulus);
+        EXPECT_EQ(BigInteger(power[i]),
+                  ArithmeticOperations::modular_pow(x, BigInteger(65537), modulus));
+    }
+}
+
+TEST(ModularKernelsTest, VectorKernelsMatchScalarReference)
+{
+    std::mt19937_64 gen(2024);
+    for (SimdLevel level : vectorLevels())
+    {
+        SCOPED_TRACE(static_cast<int>(level));
+        expectKernelsMatchReference<uint32_t>(gen, level);
+        expectKernelsMatchReference<uint64_t>(gen, level);
+    }
+}
+
+TEST(ModularKernelsTest, ScalarMultiplierAtOrAboveModulusIsReduced)
+{
+    std::mt19937_64 gen(77);
+    auto levels = vectorLevels();
+    levels.insert(levels.begin(), SimdLevel::Scalar);
+    for (SimdLevel level : levels)
+    {
+        SCOPED_TRACE(static_cast<int>(level));
+        expectUnreducedScalarMultiplier<uint32_t>(gen, level);
+        expectUnreducedScalarMultiplier<uint64_t>(gen, level);
+    }
+}
+
+TEST(ModularKernelsTest, FermatInversesOfNttPrimeResidues)
+{
+    // 15 * 2^27 + 1 and 2^64 - 2^32 + 1, the usual 32- and 64-bit NTT primes.
+    const uint32_t p32 = 2013265921;
+    const uint64_t p64 = 0xFFFFFFFF00000001ULL;
+
+    std::vector<uint32_t> a32(100);
+    std::vector<uint64_t> a64(100);
+    for (size_t i = 0; i < a32.size(); ++i)
+    {
+        a32[i] = static_cast<uint32_t>(i + 1);
+        a64[i] = p64 - i - 1;
+    }
+
+    std::vector<uint32_t> inverse32(a32.size());
+    std::vector<uint64_t> inverse64(a64.size());
+    ModularKernels::mod_pow_batch(inverse32, a32, p32 - 2, p32);
+    ModularKernels::mod_pow_batch(inverse64, a64, p64 - 2, p64);
+
+    std::vector<uint32_t> one32(a32.size());
+    std::vector<uint64_t> one64(a64.size());
+    ModularKernels::mod_mul(one32, a32, inverse32, p32);
+    ModularKernels::mod_mul(one64, a64, inverse64, p64);
+    EXPECT_EQ(one32, std::vector<uint32_t>(a32.size(), 1));
+    EXPECT_EQ(one64, std::vector<uint64_t>(a64.size(), 1));
+}
+
+TEST(ModularKernelsTest, RejectsInvalidArguments)
+{
+    std::vector<uint64_t> a(4), b(5), r(4);
+    EXPECT_THROW(ModularKernels::mod_add(r, a, b, uint64_t(7)), std::invalid_argument);
+    EXPECT_THROW(ModularKernels::mod_mul(r, a, a, uint64_t(0)), std::domain_error);
+    EXPECT_THROW(ModularKernels::mod_pow_batch(b, a, 3, uint64_t(7)), std::invalid_argument);
+    EXPECT_EQ(CpuFeatures::supported(SimdLevel::Scalar), SimdLevel::Scalar);
+}
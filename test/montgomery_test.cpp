@@ -0,0 +1,251 @@
+#include <biginteger/biginteger.hpp>
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+using namespace Numerics::detail;
+
+class MontgomeryTest : public ::testing::Test
+{
+protected:
+    using BigInteger = Numerics::BigInteger;
+    using Context = MontgomeryContext<BigInteger::inline_limbs>;
+
+    std::mt19937_64 gen{314159};
+
+    BigInteger randomBelow(const BigInteger& bound)
+    {
+        std::vector<uint64_t> limbs(bound.limb_count());
+        for (auto& limb : limbs)
+            limb = gen() % 4 == 0 ? ~uint64_t(0) : gen();
+        return BigInteger::from_limbs(limbs) % bound;
+    }
+
+    BigInteger oddModulus(size_t limbs)
+    {
+        std::vector<uint64_t> value(limbs);
+        for (auto& limb : value)
+            limb = gen();
+        value[0] |= 1;
+        value.back() |= gen() % 2 == 0 ? uint64_t(1) << 63 : uint64_t(1);
+        return BigInteger::from_limbs(value);
+    }
+};
+
+TEST_F(MontgomeryTest, PrecomputesConstants)
+{
+    const BigInteger modulus("1000000000000000000000000000057");
+    const Context context(modulus);
+
+    EXPECT_EQ(context.size(), 2U);
+    EXPECT_EQ(modulus.limbs()[0] * context.neg_inverse(), ~uint64_t(0));
+    EXPECT_EQ(context.one(), (BigInteger(1) << 128) % modulus);
+    EXPECT_EQ(context.from_mont(context.one()), BigInteger(1));
+}
+
+TEST_F(MontgomeryTest, RoundTripsAndMultiplies)
+{
+    for (size_t limbs : {1, 2, 3, 8, 33, 70})
+    {
+        const BigInteger modulus = oddModulus(limbs);
+        const Context context(modulus);
+
+        for (int i = 0; i < 20; ++i)
+        {
+            const BigInteger a = randomBelow(modulus);
+            const BigInteger b = randomBelow(modulus);
+            const BigInteger am = context.to_mont(a);
+            const BigInteger bm = context.to_mont(b);
+
+            EXPECT_EQ(context.from_mont(am), a);
+            EXPECT_EQ(context.from_mont(context.mul(am, bm)), a * b % modulus) << limbs;
+            EXPECT_EQ(context.sqr(am), context.mul(am, am)) << limbs;
+        }
+
+        const BigInteger top = modulus - 1;
+        EXPECT_EQ(context.from_mont(context.sqr(context.to_mont(top))), BigInteger(1));
+    }
+}
+
+TEST_F(MontgomeryTest, ReducesNegativeAndOversizedInputs)
+{
+    const BigInteger modulus = oddModulus(4);
+    const Context context(modulus);
+    const BigInteger x = (BigInteger(1) << 1000) + 12345;
+
+    EXPECT_EQ(context.from_mont(context.to_mont(x)), x % modulus);
+    EXPECT_EQ(context.from_mont(context.to_mont(-x)), modulus - x % modulus);
+}
+
+TEST_F(MontgomeryTest, LimbLevelOperationsAcceptAliasing)
+{
+    const BigInteger modulus = oddModulus(5);
+    const Context context(modulus);
+    const BigInteger a = randomBelow(modulus);
+
+    std::vector<uint64_t> value(context.size());
+    std::vector<uint64_t> scratch(context.scratch_size());
+    std::copy(a.limbs().begin(), a.limbs().end(), value.begin());
+
+    context.to_mont(value.data(), value.data(), scratch.data());
+    context.sqr(value.data(), value.data(), scratch.data());
+    context.mul(value.data(), value.data(), value.data(), scratch.data());
+    context.from_mont(value.data(), value.data(), scratch.data());
+
+    EXPECT_EQ(BigInteger::from_limbs(value), a.pow(4) % modulus);
+}
+
+TEST_F(MontgomeryTest, LimbLevelAddSubtractAndHalve)
+{
+    for (size_t limbs : {1, 3, 8})
+    {
+        const BigInteger modulus = oddModulus(limbs);
+        const Context context(modulus);
+        std::vector<uint64_t> scratch(context.scratch_size());
+
+        for (int i = 0; i < 20; ++i)
+        {
+            const BigInteger a = i == 0 ? modulus - 1 : randomBelow(modulus);
+            const BigInteger b = i == 0 ? modulus - 2 : randomBelow(modulus);
+            std::vector<uint64_t> x(context.size());
+            std::vector<uint64_t> y(context.size());
+            std::copy(a.limbs().begin(), a.limbs().end(), x.begin());
+            std::copy(b.limbs().begin(), b.limbs().end(), y.begin());
+
+            std::vector<uint64_t> r(context.size());
+            context.add(r.data(), x.data(), y.data(), scratch.data());
+            EXPECT_EQ(BigInteger::from_limbs(r), (a + b) % modulus);
+
+            context.sub(r.data(), x.data(), y.data());
+            EXPECT_EQ(BigInteger::from_limbs(r), ((a - b) % modulus + modulus) % modulus);
+
+            context.half(x.data(), x.data());
+            EXPECT_EQ((BigInteger::from_limbs(x) * 2) % modulus, a);
+        }
+    }
+}
+
+TEST_F(MontgomeryTest, RejectsEvenOrNonPositiveModuli)
+{
+    EXPECT_THROW(Context(BigInteger(10)), std::domain_error);
+    EXPECT_THROW(Context(BigInteger(0)), std::domain_error);
+    EXPECT_THROW(Context(BigInteger(-7)), std::domain_error);
+}
+
+TEST_F(MontgomeryTest, SlidingWindowPowMatchesRepeatedSquaring)
+{
+    for (size_t limbs : {1, 3, 8})
+    {
+        const BigInteger modulus = oddModulus(limbs);
+        const Context context(modulus);
+
+        for (size_t exponentLimbs : {0, 1, 4, 40})
+        {
+            const BigInteger exponent =
+                exponentLimbs == 0 ? BigInteger(0) : randomBelow(oddModulus(exponentLimbs));
+            const BigInteger base = randomBelow(modulus);
+
+            BigInteger expected = BigInteger(1) % modulus;
+            for (size_t i = exponent.bit_length(); i-- > 0;)
+            {
+                expected = expected * expected % modulus;
+                if (exponent.test_bit(i))
+                    expected = expected * base % modulus;
+            }
+
+            EXPECT_EQ(context.pow(base, exponent), expected) << limbs << " " << exponentLimbs;
+            EXPECT_EQ(ArithmeticOperations::modular_pow(base, exponent, modulus), expected);
+        }
+    }
+
+    const BigInteger modulus = oddModulus(2);
+    const Context context(modulus);
+    EXPECT_EQ(context.pow(-BigInteger(3), BigInteger(3)), (modulus - 27) % modulus);
+    EXPECT_EQ(Context(BigInteger(1)).pow(BigInteger(5), BigInteger(0)), BigInteger(0));
+    EXPECT_THROW(static_cast<void>(context.pow(BigInteger(2), BigInteger(-1))), std::domain_error);
+}
+
+TEST_F(MontgomeryTest, SlidingWindowNeedsFewerMultiplications)
+{
+    const BigInteger exponent = (BigInteger(1) << 2048) - 1;
+    size_t squarings = 0;
+    size_t multiplications = 0;
+
+    const size_t window = ArithmeticOperations::exponent_window_size(exponent.bit_length());
+    ArithmeticOperations::sliding_window(
+        exponent, window, [&] { ++squarings; }, [&](size_t odd) {
+            EXPECT_EQ(odd % 2, 1U);
+            EXPECT_LT(odd, size_t(1) << window);
+            ++multiplications;
+        });
+
+    EXPECT_EQ(window, 6U);
+    EXPECT_EQ(squarings, 2048U);
+    EXPECT_EQ(multiplications, (2048U + window - 1) / window);
+}
+
+TEST_F(MontgomeryTest, ConstantTimePowMatchesVariableTime)
+{
+    for (size_t limbs : {1, 2, 5, 9})
+    {
+        const BigInteger modulus = oddModulus(limbs);
+        const Context context(modulus);
+
+        for (size_t exponentLimbs : {1, 2, 3, 17})
+        {
+            const BigInteger exponent = randomBelow(oddModulus(exponentLimbs));
+            const BigInteger base = randomBelow(modulus);
+
+            EXPECT_EQ(context.pow<ConstantTime>(base, exponent), context.pow(base, exponent))
+                << limbs << " " << exponentLimbs;
+            EXPECT_EQ(ArithmeticOperations::modular_pow<ConstantTime>(base, exponent, modulus),
+                      context.pow(base, exponent));
+        }
+
+        // Zero digits select the Montgomery one from the table; an all-zero exponent gives 1.
+        const BigInteger sparse = (BigInteger(1) << 200) + 1;
+        EXPECT_EQ(context.pow<ConstantTime>(BigInteger(3), sparse),
+                  context.pow(BigInteger(3), sparse));
+        EXPECT_EQ(context.pow<ConstantTime>(BigInteger(3), BigInteger(0)), BigInteger(1));
+    }
+
+    EXPECT_EQ(Context(BigInteger(1)).pow<ConstantTime>(BigInteger(5), BigInteger(7)),
+              BigInteger(0));
+    EXPECT_THROW(ArithmeticOperations::modular_pow<ConstantTime>(BigInteger(2), BigInteger(3),
+                                                                 BigInteger(10)),
+                 std::domain_error);
+}
+
+TEST_F(MontgomeryTest, NativeReducerMatchesWideProducts)
+{
+    for (int i = 0; i < 200; ++i)
+    {
+        uint64_t modulus = (gen() >> (gen() % 64)) | 1;
+        if (i % 4 == 0)
+            modulus |= uint64_t(1) << 63;
+        const MontgomeryReducer<uint64_t> reducer(modulus);
+        const BarrettReducer<uint64_t> reference(modulus);
+
+        EXPECT_EQ(reducer.from_mont(reducer.one()), 1 % modulus);
+        for (int j = 0; j < 20; ++j)
+        {
+            const uint64_t a = gen();
+            const uint64_t b = gen() % modulus;
+
+            EXPECT_EQ(reducer.from_mont(reducer.mul(reducer.to_mont(a), reducer.to_mont(b))),
+                      reference.multiply(a, b));
+            EXPECT_EQ(reducer.pow(a, b), ArithmeticOperations::modular_pow(a, b, modulus));
+        }
+    }
+
+    const MontgomeryReducer<uint32_t> small(4294967291u);
+    EXPECT_EQ(small.pow(2, 4294967290u), 1u);
+    EXPECT_EQ(small.pow(4294967290u, 3), 4294967290u);
+}
+
+TEST_F(MontgomeryTest, NativeReducerRejectsEvenModuli)
+{
+    EXPECT_THROW(MontgomeryReducer<uint64_t>(0), std::domain_error);
+    EXPECT_THROW(MontgomeryReducer<uint32_t>(1u << 20), std::domain_error);
+    EXPECT_EQ(MontgomeryReducer<uint8_t>(1).pow(200, 5), 0);
+}
@@ -0,0 +1,236 @@
+#include <biginteger/biginteger.hpp>
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+using namespace Numerics::detail;
+
+class MultiplicationTest : public ::testing::Test
+{
+protected:
+    std::mt19937_64 gen{12345};
+
+    std::vector<uint64_t> randomLimbs(size_t n)
+    {
+        std::vector<uint64_t> limbs(n);
+        const auto mode = gen() % 3;
+        for (auto& limb : limbs)
+        {
+            if (mode == 0)
+                limb = ~uint64_t(0);
+            else if (mode == 1)
+                limb = gen();
+            else
+                limb = (gen() % 4 == 0) ? 0 : gen();
+        }
+        return limbs;
+    }
+
+    std::vector<uint64_t> reference(const std::vector<uint64_t>& a, const std::vector<uint64_t>& b)
+    {
+        std::vector<uint64_t> r(a.size() + b.size());
+        LimbArithmetic::mul_basecase(r.data(), a.data(), a.size(), b.data(), b.size());
+        return r;
+    }
+
+    template <typename Kernel>
+    void checkKernel(Kernel kernel, size_t an, size_t bn)
+    {
+        const auto a = randomLimbs(an);
+        const auto b = randomLimbs(bn);
+        std::vector<uint64_t> r(an + bn);
+        std::vector<uint64_t> scratch(Multiplication::scratch_size(an));
+
+        kernel(r.data(), a.data(), an, b.data(), bn, scratch.data());
+        EXPECT_EQ(r, reference(a, b)) << "an=" << an << " bn=" << bn;
+    }
+};
+
+TEST_F(MultiplicationTest, ThresholdsAreOrdered)
+{
+    EXPECT_GE(MultiplicationThresholds::KARATSUBA, 4U);
+    EXPECT_LE(MultiplicationThresholds::KARATSUBA, MultiplicationThresholds::TOOM3);
+    EXPECT_LE(MultiplicationThresholds::TOOM3, MultiplicationThresholds::TOOM4);
+    EXPECT_LE(MultiplicationThresholds::TOOM4, MultiplicationThresholds::NTT);
+}
+
+TEST_F(MultiplicationTest, KaratsubaMatchesSchoolbook)
+{
+    for (size_t an = 2; an < 120; an += 3)
+    {
+        checkKernel(Multiplication::karatsuba, an, an);
+        checkKernel(Multiplication::karatsuba, an, (an + 1) / 2 + 1);
+    }
+}
+
+TEST_F(MultiplicationTest, Toom3MatchesSchoolbook)
+{
+    for (size_t an = 3; an < 150; an += 4)
+    {
+        checkKernel(Multiplication::toom3, an, an);
+        checkKernel(Multiplication::toom3, an, 2 * ((an + 2) / 3) + 1);
+    }
+}
+
+TEST_F(MultiplicationTest, Toom4MatchesSchoolbook)
+{
+    for (size_t an = 4; an < 200; an += 5)
+    {
+        if (an <= 3 * ((an + 3) / 4))
+            continue;
+        checkKernel(Multiplication::toom4, an, an);
+        checkKernel(Multiplication::toom4, an, 3 * ((an + 3) / 4) + 1);
+    }
+}
+
+TEST_F(MultiplicationTest, DispatcherHandlesUnbalancedOperands)
+{
+    const size_t sizes[][2] = {{1, 1},     {40, 1},    {100, 30},  {300, 25},  {700, 700},
+                               {700, 260}, {1100, 900}, {1500, 40}, {2000, 1999}};
+
+    for (const auto& size : sizes)
+    {
+        const auto a = randomLimbs(size[0]);
+        const auto b = randomLimbs(size[1]);
+        std::vector<uint64_t> r(a.size() + b.size());
+
+        Multiplication::multiply(r.data(), b.data(), b.size(), a.data(), a.size());
+        EXPECT_EQ(r, reference(a, b)) << "an=" << size[0] << " bn=" << size[1];
+    }
+}
+
+TEST_F(MultiplicationTest, NttPrimesSupportLargeTransforms)
+{
+    using ntt = NumberTheoreticTransform;
+
+    for (const auto& prime : ntt::PRIMES)
+    {
+        const uint64_t order = prime.modulus - 1;
+        EXPECT_EQ(order % (uint64_t(1) << ntt::MAX_LOG_LENGTH), 0U);
+
+        // A primitive root has order exactly p - 1, so its (p - 1) / 2 power is -1.
+        EXPECT_EQ(ArithmeticOperations::modular_pow<uint64_t>(prime.generator, order / 2,
+                                                               prime.modulus),
+                  order);
+    }
+}
+
+TEST_F(MultiplicationTest, NttFieldRoundTrips)
+{
+    const NumberTheoreticTransform::Field field(NumberTheoreticTransform::PRIMES[0].modulus);
+    const uint64_t p = field.modulus();
+
+    for (uint64_t x : {uint64_t(0), uint64_t(1), p - 1, ~uint64_t(0)})
+        EXPECT_EQ(field.from_montgomery(field.to_montgomery(x)), x % p);
+
+    const uint64_t a = field.to_montgomery(123456789);
+    const uint64_t b = field.to_montgomery(p - 2);
+    EXPECT_EQ(field.from_montgomery(field.mul(a, b)), p - 2 * 123456789);
+    EXPECT_EQ(field.from_montgomery(field.sub(a, b)), 123456789 + 2);
+}
+
+TEST_F(MultiplicationTest, NttMatchesToom)
+{
+    const size_t sizes[][2] = {{1, 1}, {3, 2}, {64, 64}, {500, 17}, {777, 777}, {1024, 1023}};
+
+    for (const auto& size : sizes)
+    {
+        const auto a = randomLimbs(size[0]);
+        const auto b = randomLimbs(size[1]);
+        std::vector<uint64_t> r(a.size() + b.size());
+        std::vector<uint64_t> scratch(Multiplication::scratch_size(a.size()));
+
+        NumberTheoreticTransform::multiply(r.data(), a.data(), a.size(), b.data(), b.size());
+
+        std::vector<uint64_t> expected(a.size() + b.size());
+        Multiplication::mul(expected.data(), a.data(), a.size(), b.data(), b.size(),
+                            scratch.data());
+        EXPECT_EQ(r, expected) << "an=" << size[0] << " bn=" << size[1];
+    }
+}
+
+TEST_F(MultiplicationTest, SquaringKernelsMatchSchoolbook)
+{
+    for (size_t n = 1; n < 60; ++n)
+    {
+        const auto a = randomLimbs(n);
+        std::vector<uint64_t> r(2 * n);
+        LimbArithmetic::sqr_basecase(r.data(), a.data(), n);
+        EXPECT_EQ(r, reference(a, a)) << "n=" << n;
+    }
+
+    const auto checkSquare = [this](auto kernel, size_t n) {
+        const auto a = randomLimbs(n);
+        std::vector<uint64_t> r(2 * n);
+        std::vector<uint64_t> scratch(Multiplication::scratch_size(n));
+
+        kernel(r.data(), a.data(), n, scratch.data());
+        EXPECT_EQ(r, reference(a, a)) << "n=" << n;
+    };
+
+    for (size_t n = 2; n < 120; n += 3)
+        checkSquare(Multiplication::karatsuba_sqr, n);
+    for (size_t n = 3; n < 150; n += 4)
+        checkSquare(Multiplication::toom3_sqr, n);
+    for (size_t n = 13; n < 200; n += 5)
+        checkSquare(Multiplication::toom4_sqr, n);
+}
+
+TEST_F(MultiplicationTest, AliasedOperandsAreSquared)
+{
+    for (size_t n : {1, 30, 250, 700, 1500, 2100})
+    {
+        const auto a = randomLimbs(n);
+        std::vector<uint64_t> squared(2 * n);
+        std::vector<uint64_t> ntt(2 * n);
+        const auto copy = a;
+
+        Multiplication::multiply(squared.data(), a.data(), n, a.data(), n);
+        NumberTheoreticTransform::square(ntt.data(), a.data(), n);
+
+        std::vector<uint64_t> expected(2 * n);
+        Multiplication::multiply(expected.data(), a.data(), n, copy.data(), n);
+        EXPECT_EQ(squared, expected) << "n=" << n;
+        EXPECT_EQ(ntt, expected) << "n=" << n;
+    }
+}
+
+TEST_F(MultiplicationTest, BigIntegerPowUsesSquaring)
+{
+    using Numerics::BigInteger;
+
+    const BigInteger x("-98765432109876543210987654321");
+    BigInteger expected(1);
+    for (int i = 0; i < 37; ++i)
+        expected *= x;
+
+    EXPECT_EQ(x.pow(37), expected);
+    EXPECT_EQ(x.pow(0), BigInteger(1));
+    EXPECT_EQ(BigInteger(0).pow(5), BigInteger(0));
+    EXPECT_EQ(x.square(), x * BigInteger(x));
+    EXPECT_EQ(BigInteger(2).pow(100000), BigInteger(1) << 100000);
+
+    BigInteger y = (BigInteger(1) << 200000) - 1;
+    const BigInteger z = y * BigInteger(y);
+    y *= y;
+    EXPECT_EQ(y, z);
+}
+
+TEST_F(MultiplicationTest, BigIntegerUsesFastMultiplication)
+{
+    using Numerics::BigInteger;
+
+    // (2^n - 1)^2 = 2^2n - 2^(n+1) + 1 exercises every carry chain in the recombination steps.
+    for (size_t bits : {1000, 20000, 70000, 300000})
+    {
+        const BigInteger ones = (BigInteger(1) << bits) - 1;
+        EXPECT_EQ(ones * ones, (BigInteger(1) << (2 * bits)) - (BigInteger(1) << (bits + 1)) + 1);
+    }
+
+    const BigInteger a = (BigInteger(3) << 40000) + BigInteger("123456789123456789");
+    const BigInteger b = (BigInteger(7) << 30000) - 1;
+    const BigInteger product = a * b;
+    EXPECT_EQ(product / b, a);
+    EXPECT_TRUE((product % a).is_zero());
+    EXPECT_EQ((-a) * b, -product);
+}
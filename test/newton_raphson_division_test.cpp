@@ -1,5 +1,7 @@
 #include <biginteger/biginteger.hpp>
 #include <gtest/gtest.h>
+#include <random>
+#include <vector>
 
 using namespace Numerics::detail;
 
@@ -206,6 +208,74 @@ TEST_F(NewtonRaphsonDivisionTest, PerformanceCheck)
     SUCCEED() << "Performance test completed";
 }
 
+class NewtonRaphsonBigIntegerTest : public ::testing::Test
+{
+protected:
+    using BigInteger = Numerics::BigInteger;
+
+    std::mt19937_64 gen{99};
+
+    BigInteger randomValue(size_t bits)
+    {
+        std::vector<uint64_t> limbs((bits + 63) / 64);
+        for (auto& limb : limbs)
+            limb = gen() % 5 == 0 ? ~uint64_t(0) : gen();
+        const BigInteger value = BigInteger::from_limbs(limbs) >> (limbs.size() * 64 - bits);
+        return value + (BigInteger(1) << (bits - 1));
+    }
+};
+
+TEST_F(NewtonRaphsonBigIntegerTest, ReciprocalIsExactFloor)
+{
+    // Sizes above RECIPROCAL_BASE_BITS run several Newton steps.
+    for (size_t bits : {1, 63, 64, 65, 1000, 2049, 5000, 20000})
+    {
+        const BigInteger d = randomValue(bits);
+        for (size_t precision : {bits / 2, 2 * bits, 3 * bits + 17})
+        {
+            EXPECT_EQ(NewtonRaphsonDivision::reciprocal(d, precision),
+                      (BigInteger(1) << precision) / d)
+                << "bits=" << bits << " precision=" << precision;
+        }
+    }
+
+    const BigInteger power = BigInteger(1) << 9000;
+    EXPECT_EQ(NewtonRaphsonDivision::reciprocal(power, 18000), power);
+    EXPECT_EQ(NewtonRaphsonDivision::reciprocal(-power, 18000), -power);
+    EXPECT_THROW(NewtonRaphsonDivision::reciprocal(BigInteger(0), 10), std::domain_error);
+}
+
+TEST_F(NewtonRaphsonBigIntegerTest, ReusedReciprocalDividesExactly)
+{
+    const BigInteger d = randomValue(7000);
+    const NewtonRaphsonDivision::Reciprocal<BigInteger::inline_limbs> reciprocal(-d);
+
+    for (size_t bits : {10, 6999, 7000, 7001, 14000, 50000})
+    {
+        for (const BigInteger& a : {randomValue(bits), -randomValue(bits), d * randomValue(bits)})
+        {
+            const auto [quotient, remainder] = reciprocal.divide_with_remainder(a);
+            EXPECT_EQ(quotient, a / -d) << "bits=" << bits;
+            EXPECT_EQ(remainder, a % -d) << "bits=" << bits;
+        }
+    }
+
+    EXPECT_EQ(reciprocal.divisor(), -d);
+    EXPECT_EQ(reciprocal.divide_with_remainder(BigInteger(0)).first, BigInteger(0));
+}
+
+TEST_F(NewtonRaphsonBigIntegerTest, DivideWithRemainderAcceptsBigIntegers)
+{
+    const BigInteger a = randomValue(3000);
+    const BigInteger b = randomValue(1100);
+    const auto [quotient, remainder] = NewtonRaphsonDivision::divide_with_remainder(a, b);
+
+    EXPECT_EQ(quotient * b + remainder, a);
+    EXPECT_LT(remainder, b);
+    EXPECT_THROW(NewtonRaphsonDivision::divide_with_remainder(a, BigInteger(0)),
+                 std::domain_error);
+}
+
 int main(int argc, char** argv)
 {
     ::testing::InitGoogleTest(&argc, argv);
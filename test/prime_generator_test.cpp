@@ -0,0 +1,111 @@
+#include <biginteger/biginteger.hpp>
+#include <gtest/gtest.h>
+#include <random>
+
+using Numerics::BigInteger;
+using Numerics::PrimeGenerator;
+using Numerics::detail::ArithmeticOperations;
+
+class PrimeGeneratorTest : public ::testing::Test
+{
+protected:
+    std::mt19937_64 gen{161803};
+};
+
+TEST_F(PrimeGeneratorTest, NextPrimeMatchesTrialWalk)
+{
+    const PrimeGenerator generator;
+
+    uint64_t expected = 2;
+    for (uint64_t n = 0; n < 20000; ++n)
+    {
+        if (n > expected)
+        {
+            expected = n | 1;
+            while (!ArithmeticOperations::is_prime_miller_rabin(expected))
+                expected += 2;
+        }
+        EXPECT_EQ(generator.next_prime(BigInteger(n)), BigInteger(expected)) << n;
+    }
+
+    // Starts inside and just past the sieve primes, and above one limb.
+    EXPECT_EQ(generator.next_prime(BigInteger(17890)), BigInteger(17891));
+    EXPECT_EQ(generator.next_prime(BigInteger(17892)), BigInteger(17903));
+    const BigInteger two_64 = BigInteger(1) << 64;
+    EXPECT_EQ(generator.next_prime(two_64), two_64 + 13);
+    const BigInteger mersenne = (BigInteger(1) << 127) - 1;
+    EXPECT_EQ(generator.next_prime(mersenne), mersenne);
+    EXPECT_EQ(generator.next_prime(-mersenne), BigInteger(2));
+}
+
+TEST_F(PrimeGeneratorTest, GeneratesPrimesOfExactBitLength)
+{
+    const PrimeGenerator generator;
+
+    for (size_t bits = 2; bits < 140; ++bits)
+    {
+        for (int i = 0; i < 3; ++i)
+        {
+            const BigInteger prime = generator.generate(bits, gen);
+            EXPECT_EQ(prime.bit_length(), bits);
+            EXPECT_TRUE(ArithmeticOperations::is_prime_baillie_psw(prime)) << prime;
+        }
+    }
+
+    const BigInteger large = generator.generate(1024, gen);
+    EXPECT_EQ(large.bit_length(), 1024U);
+    EXPECT_TRUE(ArithmeticOperations::is_prime_baillie_psw(large));
+    EXPECT_NE(generator.generate(1024, gen), large);
+
+    EXPECT_THROW((void)generator.generate(1, gen), std::domain_error);
+}
+
+TEST_F(PrimeGeneratorTest, ThreadedSearchReturnsOnePrime)
+{
+    const PrimeGenerator generator(4);
+    EXPECT_EQ(generator.threads(), 4U);
+    EXPECT_GE(PrimeGenerator(0).threads(), 1U);
+
+    for (size_t bits : {3, 64, 65, 512})
+    {
+        const BigInteger prime = generator.generate(bits, gen);
+        EXPECT_EQ(prime.bit_length(), bits);
+        EXPECT_TRUE(ArithmeticOperations::is_prime_baillie_psw(prime)) << prime;
+    }
+}
+
+// Engine that always returns the same word, so every start it yields is the same number.
+struct ConstantEngine
+{
+    using result_type = uint64_t;
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return ~result_type(0); }
+    result_type operator()()
+    {
+        ++calls;
+        return value;
+    }
+
+    result_type value;
+    size_t calls = 0;
+};
+
+TEST_F(PrimeGeneratorTest, ThreadedSearchDrawsFromCallerEngine)
+{
+    const PrimeGenerator generator(4);
+
+    for (size_t bits : {64, 128, 200})
+    {
+        ConstantEngine engine{0x0123456789abcdefULL};
+        const BigInteger prime = generator.generate(bits, engine);
+
+        // Every worker starts from the engine's one possible value, so all find the same prime.
+        std::vector<uint64_t> limbs((bits + 63) / 64, engine.value);
+        const size_t top = (bits - 1) % 64;
+        limbs.back() &= top == 63 ? ~uint64_t(0) : (uint64_t(2) << top) - 1;
+        limbs.back() |= uint64_t(1) << top;
+        limbs.front() |= 1;
+        EXPECT_EQ(prime, generator.next_prime(BigInteger::from_limbs(limbs))) << bits;
+        EXPECT_GE(engine.calls, limbs.size());
+    }
+}
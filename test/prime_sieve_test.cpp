@@ -0,0 +1,76 @@
+#include <algorithm>
+#include <biginteger/biginteger.hpp>
+#include <gtest/gtest.h>
+#include <random>
+#include <ranges>
+#include <vector>
+
+using Numerics::PrimeSieve;
+using Numerics::detail::ArithmeticOperations;
+using Numerics::detail::SmallPrimes;
+
+namespace
+{
+
+std::vector<uint64_t> trialPrimes(uint64_t low, uint64_t high)
+{
+    std::vector<uint64_t> primes;
+    for (uint64_t n = low; n < high; ++n)
+    {
+        if (ArithmeticOperations::is_prime_miller_rabin(n))
+            primes.push_back(n);
+    }
+    return primes;
+}
+
+} // namespace
+
+TEST(PrimeSieveTest, SmallPrimeTableIsComplete)
+{
+    const auto expected = trialPrimes(3, SmallPrimes::LIMIT);
+    ASSERT_EQ(expected.size(), SmallPrimes::COUNT);
+    EXPECT_TRUE(std::equal(expected.begin(), expected.end(), SmallPrimes::ODD.begin()));
+}
+
+TEST(PrimeSieveTest, CountsPrimesBelowPowersOfTen)
+{
+    EXPECT_EQ(PrimeSieve(0, 10).count(), 4U);
+    EXPECT_EQ(PrimeSieve(0, 1000).count(), 168U);
+    EXPECT_EQ(PrimeSieve(0, 1000000).count(), 78498U);
+    EXPECT_EQ(PrimeSieve(0, 10000000, 3).count(), 664579U);
+    EXPECT_EQ(PrimeSieve(10000000, 20000000, 2).count(), 606028U);
+}
+
+TEST(PrimeSieveTest, RangesMatchTrialDivision)
+{
+    static_assert(std::ranges::input_range<const PrimeSieve>);
+
+    std::mt19937_64 gen(1729);
+    for (int i = 0; i < 200; ++i)
+    {
+        const uint64_t low = i < 20 ? uint64_t(i) : gen() >> (24 + gen() % 16);
+        const uint64_t high = low + gen() % (i % 20 == 0 ? 1500000 : 3000);
+        const auto expected = trialPrimes(low, high);
+
+        const PrimeSieve sieve(low, high, 1 + i % 3);
+        std::vector<uint64_t> iterated;
+        for (uint64_t prime : sieve)
+            iterated.push_back(prime);
+
+        EXPECT_EQ(iterated, expected) << low << " " << high;
+        EXPECT_EQ(sieve.to_vector(), expected) << low << " " << high;
+        EXPECT_EQ(sieve.count(), expected.size()) << low << " " << high;
+    }
+}
+
+TEST(PrimeSieveTest, ReachesTheLimit)
+{
+    const uint64_t high = PrimeSieve::MAX_LIMIT;
+    const auto expected = trialPrimes(high - 3000, high);
+    EXPECT_EQ(PrimeSieve(high - 3000, high, 2).to_vector(), expected);
+    EXPECT_EQ(*PrimeSieve(high - 3000, high).begin(), expected.front());
+
+    EXPECT_TRUE(PrimeSieve(100, 100).begin() == PrimeSieve(100, 100).end());
+    EXPECT_EQ(PrimeSieve(24, 29).count(), 0U);
+    EXPECT_THROW(PrimeSieve(0, high + 1), std::domain_error);
+}